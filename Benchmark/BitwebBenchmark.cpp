@@ -0,0 +1,315 @@
+/*
+ * BitwebBenchmark.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+
+#include <Urho3D/Container/Sort.h>
+#include <Urho3D/Core/CoreEvents.h>
+#include <Urho3D/Core/Main.h>
+#include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
+#include <Urho3D/Engine/Engine.h>
+#include <Urho3D/Input/InputEvents.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Math/Random.h>
+
+#include "BitwebBenchmark.h"
+#include "../Gameplay/Gameplay.h"
+
+DEFINE_APPLICATION_MAIN(BitwebBenchmark);
+
+static const char* scenarioNames[] = { "idle", "gates", "combat", 0 };
+//Report names of the GameplayStage values, in order.
+static const char* gameplayStageNames[] =
+{
+	"input",
+	"archer",
+	"gates",
+	"monsterSpawn",
+	"ai",
+	"arrowSpawn",
+	"sync",
+	"collision"
+};
+static const int walkKeys[] = { KEY_W, KEY_D, KEY_S, KEY_A };
+
+static long long GetPercentile(const PODVector<long long>& sorted, unsigned percent)
+{
+	return sorted.Empty() ? 0 : sorted[(sorted.Size() - 1) * percent / 100];
+}
+
+BitwebBenchmark::BitwebBenchmark(Context* context) :
+	Urho3DPlayer(context),
+	scenario_(SCENARIO_COMBAT),
+	seed_(1),
+	warmupFrames_(60),
+	frames_(1800),
+	frame_(0),
+	scriptState_(1),
+	walkKey_(0)
+{
+}
+
+void BitwebBenchmark::Setup()
+{
+	engineParameters_["Headless"] = true;
+	engineParameters_["LogQuiet"] = true;
+
+	Urho3DPlayer::Setup();
+
+	realtime_ = false;
+	gameplayConfig_.saveTopScore_ = false;
+	gameplayConfig_.timeStages_ = true;
+
+	const Vector<String>& arguments = GetArguments();
+
+	for (unsigned x = 0; x < arguments.Size(); x++)
+	{
+		String argument = arguments[x].ToLower();
+
+		if (argument == "-nolayers")
+		{
+			gameplayConfig_.collisionLayers_ = false;
+			continue;
+		}
+
+		if (argument == "-dynamicpets")
+		{
+			gameplayConfig_.kinematicPets_ = false;
+			continue;
+		}
+
+		if (x + 1 >= arguments.Size())
+		{
+			break;
+		}
+
+		const String& value = arguments[x + 1];
+
+		if (argument == "-scenario")
+		{
+			scenario_ = (BenchmarkScenario)GetStringListIndex(value.ToLower().CString(), scenarioNames, SCENARIO_COMBAT);
+		}
+		else if (argument == "-frames")
+		{
+			frames_ = Max(ToUInt(value), 1U);
+		}
+		else if (argument == "-warmup")
+		{
+			warmupFrames_ = ToUInt(value);
+		}
+		else if (argument == "-seed")
+		{
+			seed_ = ToUInt(value);
+		}
+		else if (argument == "-monsters")
+		{
+			gameplayConfig_.monsterMax_ = ToInt(value);
+		}
+		else if (argument == "-pathlength")
+		{
+			gameplayConfig_.monsterPathLength_ = ToUInt(value);
+		}
+		else if (argument == "-thinkbudget")
+		{
+			gameplayConfig_.monsterThinkBudget_ = ToUInt(value);
+		}
+		else if (argument == "-arrows")
+		{
+			gameplayConfig_.arrowMax_ = ToInt(value);
+		}
+		else if (argument == "-randomize")
+		{
+			gameplayConfig_.randomizeGatesInterval_ = Max(ToFloat(value), 0.0f);
+		}
+		else if (argument == "-output")
+		{
+			outputPath_ = value;
+		}
+		else
+		{
+			continue;
+		}
+
+		x++;
+	}
+}
+
+void BitwebBenchmark::Start()
+{
+	SetRandomSeed(seed_);
+	SetupSubsystems();
+
+	scriptState_ = seed_ ^ 0x9E3779B9U;
+
+	if (!scriptState_)
+	{
+		scriptState_ = 1;
+	}
+
+	gameplay_ = new Gameplay(context_, this);
+
+	frameUSec_.Reserve(frames_);
+
+	SubscribeToEvent(E_BEGINFRAME, HANDLER(BitwebBenchmark, HandleBeginFrame));
+}
+
+void BitwebBenchmark::HandleBeginFrame(StringHash eventType, VariantMap& eventData)
+{
+	//Each frame is timed from its begin to the next one, so the measurement covers the whole engine loop.
+	if (frame_ > warmupFrames_)
+	{
+		frameUSec_.Push(frameTimer_.GetUSec(true));
+	}
+	else if (frame_ == warmupFrames_)
+	{
+		gameplay_->stats_.Reset();
+		frameTimer_.Reset();
+		runTimer_.Reset();
+	}
+
+	if (frameUSec_.Size() >= frames_)
+	{
+		WriteReport();
+		gameplay_->SaveTrace();
+		UnsubscribeFromEvent(E_BEGINFRAME);
+		engine_->Exit();
+		return;
+	}
+
+	RunScenario();
+	frame_++;
+}
+
+void BitwebBenchmark::RunScenario()
+{
+	if (scenario_ == SCENARIO_GATES)
+	{
+		if (frame_ % 30 == 0)
+		{
+			ClickRandomCell((frame_ / 30) & 1 ? MOUSEB_RIGHT : MOUSEB_LEFT);
+		}
+	}
+	else if (scenario_ == SCENARIO_COMBAT)
+	{
+		if (frame_ % 90 == 0)
+		{
+			gameplay_->QueueInput(INPUT_KEYUP, walkKeys[walkKey_], NO_CELL);
+			walkKey_ = (walkKey_ + 1) % 4;
+			gameplay_->QueueInput(INPUT_KEYDOWN, walkKeys[walkKey_], NO_CELL);
+		}
+
+		if (frame_ % 20 == 0)
+		{
+			gameplay_->QueueInput(INPUT_KEYDOWN, KEY_SPACE, NO_CELL);
+		}
+
+		if (frame_ % 60 == 0)
+		{
+			ClickRandomCell(MOUSEB_LEFT);
+		}
+	}
+}
+
+void BitwebBenchmark::ClickRandomCell(int buttons)
+{
+	//A private xorshift keeps the script from shifting the game's random sequence.
+	scriptState_ ^= scriptState_ << 13;
+	scriptState_ ^= scriptState_ >> 17;
+	scriptState_ ^= scriptState_ << 5;
+
+	const MazeGrid& grid = gameplay_->mazeGrid_;
+
+	if (!grid.GetNumCells())
+	{
+		return;
+	}
+
+	int index = (int)(scriptState_ % (unsigned)grid.GetNumCells());
+
+	if (grid.IsValid(index))
+	{
+		gameplay_->QueueInput(INPUT_MOUSEDOWN, buttons, index);
+	}
+}
+
+void BitwebBenchmark::WriteReport()
+{
+	PODVector<long long> sorted = frameUSec_;
+	Sort(sorted.Begin(), sorted.End());
+
+	long long total = 0;
+
+	for (unsigned x = 0; x < sorted.Size(); x++)
+	{
+		total += sorted[x];
+	}
+
+	const GameplayConfig& config = gameplayConfig_;
+	const GameplayStats& stats = gameplay_->stats_;
+	String json;
+
+	json.AppendWithFormat("{\n\t\"scenario\": \"%s\",\n\t\"seed\": %u,\n", scenarioNames[scenario_], seed_);
+	json.AppendWithFormat("\t\"maze\": { \"width\": %d, \"height\": %d, \"cells\": %d },\n",
+			gameplay_->mazeGrid_.width_, gameplay_->mazeGrid_.height_, gameplay_->mazeGrid_.GetNumCells());
+	json.AppendWithFormat("\t\"monsterMax\": %d,\n\t\"arrowMax\": %d,\n\t\"randomizeInterval\": %g,\n",
+			config.monsterMax_, config.arrowMax_, config.randomizeGatesInterval_);
+	json.AppendWithFormat("\t\"collisionLayers\": %s,\n\t\"kinematicPets\": %s,\n",
+			config.collisionLayers_ ? "true" : "false", config.kinematicPets_ ? "true" : "false");
+	json.AppendWithFormat("\t\"tickRate\": %g,\n\t\"frames\": %u,\n\t\"wallUSec\": %lld,\n",
+			tickRate_, sorted.Size(), runTimer_.GetUSec(false));
+	json.AppendWithFormat("\t\"frameUSec\": { \"mean\": %lld, \"p50\": %lld, \"p90\": %lld, \"p99\": %lld, \"max\": %lld },\n",
+			sorted.Empty() ? 0 : total / (long long)sorted.Size(), GetPercentile(sorted, 50), GetPercentile(sorted, 90),
+			GetPercentile(sorted, 99), sorted.Empty() ? 0 : sorted.Back());
+	json.Append("\t\"stages\": {\n");
+
+	for (int x = 0; x < MAX_GAMEPLAY_STAGES; x++)
+	{
+		json.AppendWithFormat("\t\t\"%s\": { \"calls\": %u, \"totalUSec\": %lld, \"meanUSec\": %g }%s\n",
+				gameplayStageNames[x], stats.calls_[x], stats.usec_[x],
+				stats.calls_[x] ? (double)stats.usec_[x] / stats.calls_[x] : 0.0, x + 1 < MAX_GAMEPLAY_STAGES ? "," : "");
+	}
+
+	json.Append("\t},\n");
+	json.AppendWithFormat("\t\"pairsPerTick\": { \"broadphase\": %g, \"manifolds\": %g, \"collisionEvents\": %g },\n",
+			stats.pairSamples_ ? (double)stats.broadphasePairs_ / stats.pairSamples_ : 0.0,
+			stats.pairSamples_ ? (double)stats.contactManifolds_ / stats.pairSamples_ : 0.0,
+			stats.pairSamples_ ? (double)stats.calls_[STAGE_COLLISION] / stats.pairSamples_ : 0.0);
+	json.AppendWithFormat("\t\"flowField\": { \"builds\": %u, \"buildExpanded\": %llu, \"repairs\": %u, \"repairExpanded\": %llu, "
+			"\"changedGates\": %llu, \"expandedPerGate\": %g },\n",
+			stats.flowBuilds_, stats.flowBuildExpanded_, stats.flowRepairs_, stats.flowRepairExpanded_, stats.flowRepairGates_,
+			stats.flowRepairGates_ ? (double)stats.flowRepairExpanded_ / stats.flowRepairGates_ : 0.0);
+	json.AppendWithFormat("\t\"gateSync\": { \"syncs\": %u, \"touched\": %llu, \"perTick\": %g },\n",
+			stats.gateSyncs_, stats.gatesTouched_, stats.gateSyncs_ ? (double)stats.gatesTouched_ / stats.gateSyncs_ : 0.0);
+	json.AppendWithFormat("\t\"monsterPool\": { \"hits\": %u, \"fallbacks\": %u, \"misses\": %u },\n",
+			stats.monsterPoolHits_, stats.monsterPoolFallbacks_, stats.monsterPoolMisses_);
+	json.AppendWithFormat("\t\"arrowPool\": { \"spawns\": %u, \"empty\": %u },\n",
+			stats.arrowSpawns_, stats.arrowPoolEmpty_);
+	json.AppendWithFormat("\t\"ai\": { \"thinkBudgetUSec\": %u, \"petsThought\": %u },\n",
+			config.monsterThinkBudget_, stats.petsThought_);
+	json.AppendWithFormat("\t\"petMoves\": { \"moves\": %u, \"cells\": %u, \"pathLength\": %u },\n",
+			stats.petMoves_, stats.petCells_, config.monsterPathLength_);
+	json.AppendWithFormat("\t\"score\": %d\n}\n", gameplay_->score_);
+
+	if (outputPath_.Empty())
+	{
+		PrintUnicode(json);
+		return;
+	}
+
+	File file(context_, outputPath_, FILE_WRITE);
+
+	if (!file.IsOpen())
+	{
+		LOGERROR("Could not write benchmark report to " + outputPath_);
+		PrintUnicode(json);
+		return;
+	}
+
+	file.Write(json.CString(), json.Length());
+}
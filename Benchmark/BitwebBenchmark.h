@@ -0,0 +1,61 @@
+/*
+ * BitwebBenchmark.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Core/Timer.h>
+
+#include "../Urho3DPlayer.h"
+
+class Gameplay;
+
+using namespace Urho3D;
+
+enum BenchmarkScenario
+{
+	SCENARIO_IDLE = 0,//No input, only the game's own timers.
+	SCENARIO_GATES,//Clicks random cells to flip gates.
+	SCENARIO_COMBAT,//Walks a square, shoots and flips gates.
+	MAX_BENCHMARK_SCENARIOS
+};
+
+//Runs Gameplay headless and unthrottled through a scripted scenario for a fixed number of frames, then writes
+//the settings, frame time percentiles and per-stage timings as JSON. Every run with the same arguments plays
+//the same game, so two builds can be compared on the numbers alone.
+class BitwebBenchmark : public Urho3DPlayer
+{
+	OBJECT(BitwebBenchmark);
+
+public:
+	BitwebBenchmark(Context* context);
+
+	virtual void Setup();
+	virtual void Start();
+
+	void HandleBeginFrame(StringHash eventType, VariantMap& eventData);
+	void RunScenario();
+	void ClickRandomCell(int buttons);
+	void WriteReport();
+
+	BenchmarkScenario scenario_;
+	unsigned seed_;
+	unsigned warmupFrames_;
+	unsigned frames_;
+	String outputPath_;
+
+	SharedPtr<Gameplay> gameplay_;
+	unsigned frame_;
+	unsigned scriptState_;
+	int walkKey_;
+	HiresTimer frameTimer_;
+	HiresTimer runTimer_;
+	PODVector<long long> frameUSec_;
+};
@@ -0,0 +1,93 @@
+/*
+ * ArrowPool.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "ArrowPool.h"
+#include "../LogicComponents/RigidBodyMoveTo.h"
+
+ArrowPool::ArrowPool() :
+	spawned_(0),
+	quiverHead_(0),
+	quiverSize_(0)
+{
+}
+
+void ArrowPool::Build(Context* context, Node* prototype, int capacity)
+{
+	Clear();
+
+	arrows_.Resize(capacity);
+	quiver_.Resize(capacity);
+
+	for (int x = 0; x < capacity; x++)
+	{
+		Node* arrow = prototype->Clone(LOCAL);
+
+		RigidBodyMoveTo* _RigidBodyMoveTo = new RigidBodyMoveTo(context);
+		arrow->AddComponent(_RigidBodyMoveTo, 0, LOCAL);
+
+		arrow->SetEnabledRecursive(false);
+		arrows_[x] = arrow;
+	}
+}
+
+Node* ArrowPool::Spawn()
+{
+	if (spawned_ >= arrows_.Size())
+	{
+		return 0;
+	}
+
+	Node* arrow = arrows_[spawned_++];
+	arrow->SetEnabledRecursive(true);
+
+	return arrow;
+}
+
+bool ArrowPool::PushQuiver(Node* arrow)
+{
+	if (quiverSize_ >= quiver_.Size())
+	{
+		return false;
+	}
+
+	quiver_[(quiverHead_ + quiverSize_) % quiver_.Size()] = arrow;
+	quiverSize_++;
+
+	return true;
+}
+
+Node* ArrowPool::PopQuiver()
+{
+	if (!quiverSize_)
+	{
+		return 0;
+	}
+
+	Node* arrow = quiver_[quiverHead_];
+	quiverHead_ = (quiverHead_ + 1) % quiver_.Size();
+	quiverSize_--;
+
+	return arrow;
+}
+
+void ArrowPool::Clear()
+{
+	for (unsigned x = 0; x < arrows_.Size(); x++)
+	{
+		arrows_[x]->Remove();
+	}
+
+	arrows_.Clear();
+	quiver_.Clear();
+	spawned_ = 0;
+	quiverHead_ = 0;
+	quiverSize_ = 0;
+}
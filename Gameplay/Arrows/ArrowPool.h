@@ -0,0 +1,46 @@
+/*
+ * ArrowPool.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+
+namespace Urho3D
+{
+class Context;
+class Node;
+}
+
+using namespace Urho3D;
+
+//Every arrow the level can hold, cloned and disabled at load. Spawning places the next unused arrow in the
+//maze. The quiver is a ring over the same capacity that fires the oldest pickup first without searching or
+//shifting.
+class ArrowPool
+{
+public:
+	ArrowPool();
+
+	void Build(Context* context, Node* prototype, int capacity);
+	Node* Spawn();
+	bool PushQuiver(Node* arrow);
+	Node* PopQuiver();
+	void Clear();
+
+	unsigned GetQuiverSize() const { return quiverSize_; }
+	unsigned GetNumSpawned() const { return spawned_; }
+
+	PODVector<Node*> arrows_;
+
+private:
+	unsigned spawned_;
+
+	PODVector<Node*> quiver_;
+	unsigned quiverHead_;
+	unsigned quiverSize_;
+};
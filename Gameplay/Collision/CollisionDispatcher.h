@@ -0,0 +1,73 @@
+/*
+ * CollisionDispatcher.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include "EntityCategory.h"
+
+using namespace Urho3D;
+
+//Table of collision handlers indexed by the categories of both nodes. A handler registered for (a, b) also
+//answers (b, a) and always receives the nodes in the order it was registered with.
+template <class T> class CollisionDispatcher
+{
+public:
+	typedef void (T::*CollisionHandler)(Node* node, Node* otherNode);
+
+	CollisionDispatcher()
+	{
+		for (int x = 0; x < MAX_ENTITY_CATEGORIES; x++)
+		{
+			for (int y = 0; y < MAX_ENTITY_CATEGORIES; y++)
+			{
+				handlers_[x][y] = 0;
+				swapped_[x][y] = false;
+			}
+		}
+	}
+
+	void Register(EntityCategory category, EntityCategory otherCategory, CollisionHandler handler)
+	{
+		handlers_[category][otherCategory] = handler;
+		swapped_[category][otherCategory] = false;
+
+		if (category != otherCategory)
+		{
+			handlers_[otherCategory][category] = handler;
+			swapped_[otherCategory][category] = true;
+		}
+	}
+
+	bool Dispatch(T* receiver, Node* nodeA, Node* nodeB) const
+	{
+		EntityCategory categoryA = GetEntityCategory(nodeA);
+		EntityCategory categoryB = GetEntityCategory(nodeB);
+		CollisionHandler handler = handlers_[categoryA][categoryB];
+
+		if (!handler)
+		{
+			return false;
+		}
+
+		if (swapped_[categoryA][categoryB])
+		{
+			(receiver->*handler)(nodeB, nodeA);
+		}
+		else
+		{
+			(receiver->*handler)(nodeA, nodeB);
+		}
+
+		return true;
+	}
+
+private:
+	CollisionHandler handlers_[MAX_ENTITY_CATEGORIES][MAX_ENTITY_CATEGORIES];
+	bool swapped_[MAX_ENTITY_CATEGORIES][MAX_ENTITY_CATEGORIES];
+};
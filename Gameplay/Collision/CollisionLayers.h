@@ -0,0 +1,71 @@
+/*
+ * CollisionLayers.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Node.h>
+
+using namespace Urho3D;
+
+//Bodies left out keep Bullet's default layer 1, the floor layer, so they still collide the way floors do.
+enum CollisionLayer
+{
+	LAYER_FLOOR = 0,
+	LAYER_GATE,
+	LAYER_ARCHER,
+	LAYER_MONSTER,
+	LAYER_ARROW,
+	LAYER_PICKUP,
+	MAX_COLLISION_LAYERS
+};
+
+//Which layers meet which. A body's mask only holds the layers it was allowed to meet, so every other pair is
+//dropped by the broadphase before it costs a narrowphase test or a collision event. When disabled, Apply()
+//leaves bodies on whatever layer and mask they were authored with.
+class CollisionMatrix
+{
+public:
+	CollisionMatrix() :
+		enabled_(true)
+	{
+		for (int x = 0; x < MAX_COLLISION_LAYERS; x++)
+		{
+			masks_[x] = 0;
+		}
+	}
+
+	void Allow(CollisionLayer layerA, CollisionLayer layerB)
+	{
+		masks_[layerA] |= 1 << layerB;
+		masks_[layerB] |= 1 << layerA;
+	}
+
+	unsigned GetMask(CollisionLayer layer) const { return masks_[layer]; }
+
+	void Apply(RigidBody* body, CollisionLayer layer) const
+	{
+		if (enabled_ && body)
+		{
+			body->SetCollisionLayerAndMask(1 << layer, masks_[layer]);
+		}
+	}
+
+	void Apply(Node* node, CollisionLayer layer) const
+	{
+		if (node)
+		{
+			Apply(node->GetComponent<RigidBody>(), layer);
+		}
+	}
+
+	bool enabled_;
+
+private:
+	unsigned masks_[MAX_COLLISION_LAYERS];
+};
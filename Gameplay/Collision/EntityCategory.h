@@ -0,0 +1,42 @@
+/*
+ * EntityCategory.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Math/StringHash.h>
+#include <Urho3D/Scene/Node.h>
+
+using namespace Urho3D;
+
+enum EntityCategory
+{
+	CATEGORY_NONE = 0,
+	CATEGORY_ARCHER,
+	CATEGORY_MONSTER,
+	CATEGORY_ARROW,
+	CATEGORY_ELF,
+	CATEGORY_CHEST,
+	CATEGORY_POTION,
+	CATEGORY_WALL,
+	MAX_ENTITY_CATEGORIES
+};
+
+//Stored as a node var so clones keep the category of the node they were cloned from.
+static const StringHash VAR_CATEGORY("Category");
+
+inline void SetEntityCategory(Node* node, EntityCategory category)
+{
+	node->SetVar(VAR_CATEGORY, (int)category);
+}
+
+inline EntityCategory GetEntityCategory(Node* node)
+{
+	const Variant& category = node->GetVar(VAR_CATEGORY);
+
+	return category.IsEmpty() ? CATEGORY_NONE : (EntityCategory)category.GetInt();
+}
@@ -26,6 +26,7 @@
 #include <Urho3D/Physics/PhysicsEvents.h>
 #include <Urho3D/Physics/PhysicsWorld.h>
 #include <Urho3D/Math/Quaternion.h>
+#include <Urho3D/Math/Random.h>
 #include <Urho3D/Graphics/Renderer.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Physics/RigidBody.h>
@@ -36,12 +37,16 @@
 #include <Urho3D/Graphics/StaticModel.h>
 #include <Urho3D/UI/Text.h>
 #include <Urho3D/Graphics/Texture2D.h>
+#include <Urho3D/Core/Timer.h>
 #include <Urho3D/UI/Text3D.h>
 #include <Urho3D/UI/UI.h>
 #include <Urho3D/UI/UIEvents.h>
 #include <Urho3D/Graphics/Viewport.h>
 
+#include <Bullet/btBulletDynamicsCommon.h>
+
 #include "Gameplay.h"
+#include "LogicComponents/MoverSystem.h"
 #include "LogicComponents/RigidBodyMoveTo.h"
 
 Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
@@ -51,6 +56,7 @@ Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
 	elapsedTime_ = 0.0f;
 	previousExtents_ = IntVector2(800, 600);
 
+	context->RegisterFactory<MoverSystem>();
 	context->RegisterFactory<RigidBodyMoveTo>();
 
 	archerSpeed_ = 20.0f;
@@ -63,7 +69,7 @@ Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
 	invincible_ = false;
 
 	randomizeGatesElapsedTime_ = 10.0f;
-	randomizeGatesInterval_ = 10.0f;
+	randomizeGatesInterval_ = main_->gameplayConfig_.randomizeGatesInterval_;
 
 	monsterSpawnElapsedTime_ = 5.0f;
 	monsterSpawnInterval_ = 5.0f;
@@ -77,12 +83,42 @@ Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
 	invincibilityElapsedTime_ = 0.0f;
 	invincibilityInterval_ = 10.0f;
 
-	monsterMoveTurn_ = 0;
-	monsterMax_ = 6;
+	monsterMax_ = main_->gameplayConfig_.monsterMax_;
 	monsterCount_ = 0;
 
-	arrowCount_ = 0;
-	arrowMax_ = 5;
+	arrowMax_ = main_->gameplayConfig_.arrowMax_;
+
+	monsterCursor_ = 0;
+	monstersThought_ = 0;
+	monsterThinkBudget_ = main_->gameplayConfig_.monsterThinkBudget_;
+
+	physicsTick_ = 0;
+
+	if (!main_->tracePath_.Empty())
+	{
+		TraceRecorder::Start();
+	}
+
+	//A replay starts from the recorded seed, everything random after this point follows from it and the inputs.
+	if (!main_->replayPath_.Empty())
+	{
+		if (inputLog_.OpenReplay(context_, main_->replayPath_))
+		{
+			SetRandomSeed(inputLog_.seed_);
+		}
+		else
+		{
+			//Headless with no inputs would run forever.
+			main_->ErrorExit("Could not replay " + main_->replayPath_);
+		}
+	}
+	else if (!main_->recordPath_.Empty())
+	{
+		inputLog_.OpenRecord(context_, main_->recordPath_, GetRandomSeed());
+	}
+
+	mazeSeed_ = GetRandomSeed();
+	mazeGeneration_ = 0;
 
 	scene_ = new Scene(context_);
 	cameraNode_ = new Node(context_);
@@ -90,22 +126,82 @@ Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
 	File loadFile(context_,main_->filesystem_->GetProgramDir()
 			+ "Data/Scenes/bitweb.xml", FILE_READ);
 	scene_->LoadXML(loadFile);
+	TagEntities();
+	DeclareCollisionLayers();
+
+	if (inputLog_.IsRecording() || inputLog_.IsReplaying())
+	{
+		//Game logic reads node positions, keep them on the simulated transforms so both runs see the same values.
+		scene_->GetComponent<PhysicsWorld>()->SetInterpolation(false);
+		//A time budget would make the AI depend on how fast the machine is.
+		monsterThinkBudget_ = 0;
+	}
 
 	cameraNode_ = scene_->GetChild("camera");
 
-	main_->viewport_ = new Viewport(context_, scene_, cameraNode_->GetComponent<Camera>());
-	main_->renderer_->SetViewport(0, main_->viewport_);
-	main_->viewport_->SetScene(scene_);
-	main_->viewport_->SetCamera(cameraNode_->GetComponent<Camera>());
+	if (!main_->headless_)
+	{
+		main_->viewport_ = new Viewport(context_, scene_, cameraNode_->GetComponent<Camera>());
+		main_->renderer_->SetViewport(0, main_->viewport_);
+		main_->viewport_->SetScene(scene_);
+		main_->viewport_->SetCamera(cameraNode_->GetComponent<Camera>());
+	}
 
 	archer_ = scene_->GetChild("archer");
 	cells_ = scene_->GetChild("cells");
+	bool builtMaze = main_->gameplayConfig_.mazeWidth_ > 0 && main_->gameplayConfig_.mazeHeight_ > 0;
+
+	if (builtMaze)
+	{
+		cells_ = mazeBuilder_.Build(cells_, main_->gameplayConfig_.mazeWidth_, main_->gameplayConfig_.mazeHeight_, mazeGrid_);
+	}
+	else
+	{
+		mazeGrid_.Build(cells_);
+	}
+
+	ResolveHandles();
+	LoadGates();
+
+	if (builtMaze)
+	{
+		//Every clone starts with the prefab's gates, carve a maze into them and keep the archer on the grid.
+		mazeGenerator_.Generate(mazeGrid_, gateBoard_, mazeSeed_ + mazeGeneration_);
+		mazeGeneration_++;
+
+		Vector3 archerPos = archerHandles_.body_->GetPosition();
+
+		if (mazeGrid_.GetCellIndex(archerPos) == NO_CELL)
+		{
+			Vector3 cellPos = mazeGrid_.GetCellPosition(0);
+			archerHandles_.body_->SetPosition(Vector3(cellPos.x_, archerPos.y_, cellPos.z_));
+		}
+
+		SyncGates();
+	}
+
+	//Nothing is drawn without a window, the authored models are left as they are.
+	if (!main_->headless_)
+	{
+		mazeRenderer_.Build(scene_, mazeGrid_, cellHandles_, gateBoard_);
+	}
+
+	//Chunk bodies take their layer from the gates they replace.
+	ApplyCollisionLayers();
+	mazeColliders_.Build(scene_, mazeGrid_, cellHandles_, gateBoard_);
+
+	UpdateFlowField(true);
 	baseMonsters_.Push(scene_->GetChild("pet1"));
 	baseMonsters_.Push(scene_->GetChild("pet2"));
 	baseMonsters_.Push(scene_->GetChild("pet3"));
 	baseMonsters_.Push(scene_->GetChild("pet4"));
+	monsterPool_.kinematic_ = main_->gameplayConfig_.kinematicPets_;
+	monsterPool_.Build(context_, baseMonsters_, monsterMax_);
+	monsterPlanner_.pathLength_ = main_->gameplayConfig_.monsterPathLength_;
 
 	arrow_ = scene_->GetChild("quartz");
+	arrowPool_.Build(context_, arrow_, arrowMax_);
+	SetEntityCategory(arrow_, CATEGORY_NONE);//Only the pooled clones are arrows.
 	potion_ = scene_->GetChild("potion");
 	chest_ = scene_->GetChild("chest");
 	elf_ = scene_->GetChild("elf");
@@ -117,17 +213,26 @@ Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
 	XMLFile* xmlFile = main_->cache_->GetResource<XMLFile>("Objects/TopScore.xml");
 	topScore_ = scene_->InstantiateXML(xmlFile->GetRoot(), Vector3::ZERO, Quaternion(), LOCAL);
 
+	//The binary record wins over the xml it replaced, which only seeds the first run.
+	int storedTopScore;
+
+	if (main_->gameplayConfig_.saveTopScore_)
+	{
+		scoreStore_.Start(context_, main_->filesystem_->GetProgramDir() + "Data/Objects/TopScore.dat");
+
+		if (scoreStore_.Load(storedTopScore))
+		{
+			topScore_->SetVar("TopScore", storedTopScore);
+		}
+	}
+
 	score_ = 0;
 
 	topScoreText_ = scene_->GetChild("TopScore");
-	topScoreText_->GetComponent<Text3D>()->SetText("Top Score " + String( topScore_->GetVar("TopScore").GetInt() ));
-	topScoreText_->GetComponent<Text3D>()->SetWidth(12);
-	topScoreText_->ApplyAttributes();
-
 	scoreText_ = scene_->GetChild("Score");
-	scoreText_->GetComponent<Text3D>()->SetText("The Score " + String( score_ ));
-	scoreText_->GetComponent<Text3D>()->SetWidth(12);
-	scoreText_->ApplyAttributes();
+	//Headless runs keep the score values but never build text.
+	scoreHud_.Init(main_->headless_ ? 0 : scoreText_.Get(), main_->headless_ ? 0 : topScoreText_.Get(),
+			score_, topScore_->GetVar("TopScore").GetInt());
 
 	archerDir_ = 1;//0=up,1=down,2=left,3=right
 
@@ -141,7 +246,16 @@ Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
 	gateOpen_ = scene_->GetChild("gateOpen");
 	shootArrow_ = scene_->GetChild("shootArrow");
 
-	SubscribeToEvent(archer_->GetChild("archer"), E_NODECOLLISIONSTART, HANDLER(Gameplay, HandleNodeCollisionStart));
+	collisionDispatcher_.Register(CATEGORY_ARCHER, CATEGORY_ELF, &Gameplay::HandleArcherElf);
+	collisionDispatcher_.Register(CATEGORY_ARCHER, CATEGORY_CHEST, &Gameplay::HandleArcherChest);
+	collisionDispatcher_.Register(CATEGORY_ARCHER, CATEGORY_POTION, &Gameplay::HandleArcherPotion);
+	collisionDispatcher_.Register(CATEGORY_ARCHER, CATEGORY_ARROW, &Gameplay::HandleArcherArrow);
+	collisionDispatcher_.Register(CATEGORY_ARCHER, CATEGORY_MONSTER, &Gameplay::HandleArcherMonster);
+	collisionDispatcher_.Register(CATEGORY_ARROW, CATEGORY_WALL, &Gameplay::HandleArrowWall);
+	collisionDispatcher_.Register(CATEGORY_ARROW, CATEGORY_MONSTER, &Gameplay::HandleArrowMonster);
+
+	//One subscription covers every body in the scene, the dispatcher picks the handler.
+	SubscribeToEvent(scene_->GetComponent<PhysicsWorld>(), E_PHYSICSCOLLISIONSTART, HANDLER(Gameplay, HandlePhysicsCollisionStart));
 
 	SubscribeToEvent(E_RESIZED, HANDLER(Gameplay, HandleElementResize));
 
@@ -151,15 +265,21 @@ Gameplay::Gameplay(Context* context, Urho3DPlayer* main) :
 
     SubscribeToEvent(E_PHYSICSPRESTEP, HANDLER(Gameplay, HandlePhysicsPreStep));
 
+    SubscribeToEvent(E_POSTUPDATE, HANDLER(Gameplay, HandlePostUpdate));
+
     SubscribeToEvent(E_KEYDOWN, HANDLER(Gameplay, HandleKeyDown));
 
     SubscribeToEvent(E_KEYUP, HANDLER(Gameplay, HandleKeyUp));
 
     SubscribeToEvent(E_MOUSEBUTTONDOWN, HANDLER(Gameplay, HandleMouseDown));
+
+    SubscribeToEvent(E_EXITREQUESTED, HANDLER(Gameplay, HandleExitRequested));
 }
 
 Gameplay::~Gameplay()
 {
+	scoreStore_.Shutdown();
+	inputLog_.Close(physicsTick_);
 }
 
 void Gameplay::HandlePostRenderUpdate(StringHash eventType, VariantMap& eventData)
@@ -178,20 +298,51 @@ void Gameplay::HandleUpdate(StringHash eventType, VariantMap& eventData)
 	elapsedTime_ += timeStep;
 }
 
+void Gameplay::HandleExitRequested(StringHash eventType, VariantMap& eventData)
+{
+	//Gameplay outlives the main loop, write the pending top score before the engine goes away.
+	scoreStore_.Shutdown();
+	inputLog_.Close(physicsTick_);
+	SaveTrace();
+}
+
+void Gameplay::HandlePostUpdate(StringHash eventType, VariantMap& eventData)
+{
+	//Score changes from every physics step of the frame show up in one text rebuild.
+	scoreHud_.Flush();
+}
+
 void Gameplay::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
 {
 	using namespace PhysicsPreStep;
 
+	TRACE("PhysicsPreStep");
+
 	float timeStep = eventData[P_TIMESTEP].GetFloat();
 
+	if (main_->gameplayConfig_.timeStages_)
+	{
+		//The pair caches still hold what the last step found.
+		SampleContactPairs();
+	}
+
+	HiresTimer stageTimer;
+
+	ApplyInputs();
+	physicsTick_++;
+	EndStage(STAGE_INPUT, stageTimer);
+
 	MoveArcher();
+	EndStage(STAGE_ARCHER, stageTimer);
 
 	randomizeGatesElapsedTime_ += timeStep;
 
 	if (randomizeGatesElapsedTime_ >= randomizeGatesInterval_)
 	{
 		randomizeGatesElapsedTime_ = 0.0f;
+		stageTimer.Reset();
 		RandomizeGates();
+		EndStage(STAGE_GATES, stageTimer);
 	}
 
 	monsterSpawnElapsedTime_ += timeStep;
@@ -199,7 +350,9 @@ void Gameplay::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
 	if (monsterSpawnElapsedTime_ >= monsterSpawnInterval_)
 	{
 		monsterSpawnElapsedTime_ = 0.0f;
+		stageTimer.Reset();
 		SpawnMonster();
+		EndStage(STAGE_MONSTER_SPAWN, stageTimer);
 	}
 
 	monsterMoveElapsedTime_ += timeStep;
@@ -207,7 +360,9 @@ void Gameplay::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
 	if (monsterMoveElapsedTime_ >= monsterMoveInterval_)
 	{
 		monsterMoveElapsedTime_ = 0.0f;
+		stageTimer.Reset();
 		MoveMonsters();
+		EndStage(STAGE_AI, stageTimer);
 	}
 
 	arrowSpawnElapsedTime_ += timeStep;
@@ -215,7 +370,9 @@ void Gameplay::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
 	if (arrowSpawnElapsedTime_ >= arrowSpawnInterval_)
 	{
 		arrowSpawnElapsedTime_ = 0.0f;
+		stageTimer.Reset();
 		SpawnArrow();
+		EndStage(STAGE_ARROW_SPAWN, stageTimer);
 	}
 
 	if (invincible_)
@@ -224,11 +381,24 @@ void Gameplay::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
 
 		if (invincibilityElapsedTime_ >= invincibilityInterval_)
 		{
-			archer_->GetChild("archer")->GetChild("invincibilitysparkle")->SetEnabled(false);
+			archerHandles_.sparkle_->SetEnabled(false);
 			invincibilityElapsedTime_ = 0.0f;
 			invincible_ = false;
 		}
 	}
+
+	stageTimer.Reset();
+	SyncGates();
+	EndStage(STAGE_SYNC, stageTimer);
+}
+
+void Gameplay::EndStage(GameplayStage stage, HiresTimer& stageTimer)
+{
+	if (main_->gameplayConfig_.timeStages_)
+	{
+		stats_.usec_[stage] += stageTimer.GetUSec(true);
+		stats_.calls_[stage]++;
+	}
 }
 
 void Gameplay::HandleElementResize(StringHash eventType, VariantMap& eventData)
@@ -267,252 +437,444 @@ void Gameplay::HandleReleased(StringHash eventType, VariantMap& eventData)
 	UIElement* ele = static_cast<UIElement*>(eventData[ElementAdded::P_ELEMENT].GetPtr());
 }
 
-void Gameplay::HandleNodeCollisionStart(StringHash eventType, VariantMap& eventData)
+void Gameplay::HandlePhysicsCollisionStart(StringHash eventType, VariantMap& eventData)
+{
+	using namespace PhysicsCollisionStart;
+
+	TRACE("PhysicsCollisionStart");
+
+	Node* nodeA = static_cast<Node*>(eventData[P_NODEA].GetPtr());
+	Node* nodeB = static_cast<Node*>(eventData[P_NODEB].GetPtr());
+
+	HiresTimer stageTimer;
+
+	collisionDispatcher_.Dispatch(this, nodeA, nodeB);
+	EndStage(STAGE_COLLISION, stageTimer);
+}
+
+void Gameplay::HandleArcherElf(Node* archer, Node* elf)
 {
-	using namespace NodeCollisionStart;
+	score_ += 2;
 
-	Node* noed = static_cast<RigidBody*>(eventData[P_BODY].GetPtr())->GetNode();
-	Node* otherNode = static_cast<Node*>(eventData[P_OTHERNODE].GetPtr());
-	bool trigger = eventData[P_TRIGGER].GetBool();
+	scoreHud_.SetScore(score_);
 
-	if (noed->GetName() == "archer")
+	if (score_ > topScore_->GetVar("TopScore").GetInt())
 	{
-		if (otherNode->GetName() == "elf")
-		{
-			score_ += 2;
+		topScore_->SetVar("TopScore", score_);
+		scoreHud_.SetTopScore(score_);
+	}
 
-			scoreText_->GetComponent<Text3D>()->SetText("The Score " + String( score_ ));
-			scoreText_->GetComponent<Text3D>()->SetWidth(12);
-			scoreText_->ApplyAttributes();
+	SpawnElf();
 
-			if (score_ > topScore_->GetVar("TopScore").GetInt())
-			{
-				topScore_->SetVar("TopScore", score_);
-				topScoreText_->GetComponent<Text3D>()->SetText("Top Score " + String( topScore_->GetVar("TopScore").GetInt() ));
-				topScoreText_->GetComponent<Text3D>()->SetWidth(12);
-				topScoreText_->ApplyAttributes();
-			}
+	PlaySound(archerHitElf_);
+}
 
-			SpawnElf();
+void Gameplay::HandleArcherChest(Node* archer, Node* chest)
+{
+	score_++;
 
-			archerHitElf_->GetComponent<SoundSource>()->Play(archerHitElf_->GetComponent<SoundSource>()->GetSound());
-		}
-		else if (otherNode->GetName() == "chest")
-		{
-			score_++;
+	scoreHud_.SetScore(score_);
 
-			scoreText_->GetComponent<Text3D>()->SetText("The Score " + String( score_ ));
-			scoreText_->GetComponent<Text3D>()->SetWidth(12);
-			scoreText_->ApplyAttributes();
+	if (score_ > topScore_->GetVar("TopScore").GetInt())
+	{
+		topScore_->SetVar("TopScore", score_);
+		scoreHud_.SetTopScore(score_);
+	}
 
-			if (score_ > topScore_->GetVar("TopScore").GetInt())
-			{
-				topScore_->SetVar("TopScore", score_);
-				topScoreText_->GetComponent<Text3D>()->SetText("Top Score " + String( topScore_->GetVar("TopScore").GetInt() ));
-				topScoreText_->GetComponent<Text3D>()->SetWidth(12);
-				topScoreText_->ApplyAttributes();
-			}
+	if (main_->gameplayConfig_.saveTopScore_)
+	{
+		scoreStore_.Submit(topScore_->GetVar("TopScore").GetInt());
+	}
+	SpawnChest();
 
-			File saveFile(context_, main_->filesystem_->GetProgramDir() + "Data/Objects/TopScore.xml", FILE_WRITE);
-			topScore_->SaveXML(saveFile);
-			SpawnChest();
+	PlaySound(archerHitChest_);
+}
 
-			archerHitChest_->GetComponent<SoundSource>()->Play(archerHitChest_->GetComponent<SoundSource>()->GetSound());
-		}
-		else if (otherNode->GetName() == "potion")
-		{
-			score_++;
+void Gameplay::HandleArcherPotion(Node* archer, Node* potion)
+{
+	score_++;
 
-			scoreText_->GetComponent<Text3D>()->SetText("The Score " + String( score_ ));
-			scoreText_->GetComponent<Text3D>()->SetWidth(12);
-			scoreText_->ApplyAttributes();
+	scoreHud_.SetScore(score_);
 
-			if (score_ > topScore_->GetVar("TopScore").GetInt())
-			{
-				topScore_->SetVar("TopScore", score_);
-				topScoreText_->GetComponent<Text3D>()->SetText("Top Score " + String( topScore_->GetVar("TopScore").GetInt() ));
-				topScoreText_->GetComponent<Text3D>()->SetWidth(12);
-				topScoreText_->ApplyAttributes();
-			}
+	if (score_ > topScore_->GetVar("TopScore").GetInt())
+	{
+		topScore_->SetVar("TopScore", score_);
+		scoreHud_.SetTopScore(score_);
+	}
 
-			archer_->GetChild("archer")->GetChild("invincibilitysparkle")->SetEnabled(true);
-			invincibilityElapsedTime_ = 0.0f;
-			invincible_ = true;
-			SpawnPotion();
+	archerHandles_.sparkle_->SetEnabled(true);
+	invincibilityElapsedTime_ = 0.0f;
+	invincible_ = true;
+	SpawnPotion();
 
-			archerHitPotion_->GetComponent<SoundSource>()->Play(archerHitPotion_->GetComponent<SoundSource>()->GetSound());
-		}
-		else if (otherNode->GetName() == "quartz")
-		{
-			if (otherNode->GetVar("Fired").GetBool())
-			{
-				return;
-			}
+	PlaySound(archerHitPotion_);
+}
 
-			score_++;
+void Gameplay::HandleArcherArrow(Node* archer, Node* arrow)
+{
+	if (arrow->GetVar("Fired").GetBool())
+	{
+		return;
+	}
 
-			scoreText_->GetComponent<Text3D>()->SetText("The Score " + String( score_ ));
-			scoreText_->GetComponent<Text3D>()->SetWidth(12);
-			scoreText_->ApplyAttributes();
+	score_++;
 
-			if (score_ > topScore_->GetVar("TopScore").GetInt())
-			{
-				topScore_->SetVar("TopScore", score_);
-				topScoreText_->GetComponent<Text3D>()->SetText("Top Score " + String( topScore_->GetVar("TopScore").GetInt() ));
-				topScoreText_->GetComponent<Text3D>()->SetWidth(12);
-				topScoreText_->ApplyAttributes();
-			}
+	scoreHud_.SetScore(score_);
 
-			otherNode->SetEnabledRecursive(false);
-			quiver_.Push(otherNode);
+	if (score_ > topScore_->GetVar("TopScore").GetInt())
+	{
+		topScore_->SetVar("TopScore", score_);
+		scoreHud_.SetTopScore(score_);
+	}
 
-			archerHitArrow_->GetComponent<SoundSource>()->Play(archerHitArrow_->GetComponent<SoundSource>()->GetSound());
-		}
-		else if (otherNode->GetName() == "pet1"
-				|| otherNode->GetName() == "pet2"
-						|| otherNode->GetName() == "pet3"
-								|| otherNode->GetName() == "pet4")
-		{
-			if (invincible_)
-			{
-				return;
-			}
-			score_--;
+	arrow->SetEnabledRecursive(false);
+	arrowPool_.PushQuiver(arrow);
 
-			if (score_ < 0)
-			{
-				score_ = 0;
-			}
+	PlaySound(archerHitArrow_);
+}
 
-			scoreText_->GetComponent<Text3D>()->SetText("The Score " + String( score_ ));
-			scoreText_->GetComponent<Text3D>()->SetWidth(12);
-			scoreText_->ApplyAttributes();
+void Gameplay::HandleArcherMonster(Node* archer, Node* monster)
+{
+	if (invincible_)
+	{
+		return;
+	}
+	score_--;
 
-			dogHitArcher_->GetComponent<SoundSource>()->Play(dogHitArcher_->GetComponent<SoundSource>()->GetSound());
-		}
+	if (score_ < 0)
+	{
+		score_ = 0;
 	}
-	else if (noed->GetName() == "quartz")//arrow
+
+	scoreHud_.SetScore(score_);
+
+	PlaySound(dogHitArcher_);
+}
+
+void Gameplay::HandleArrowWall(Node* arrow, Node* wall)
+{
+	arrow->GetComponent<RigidBodyMoveTo>()->Stop();
+	arrow->SetVar("Fired", false);
+
+	PlaySound(arrowHitWall_);
+}
+
+void Gameplay::HandleArrowMonster(Node* arrow, Node* monster)
+{
+	if (!arrow->GetVar("Fired").GetBool())
 	{
-		if (otherNode->GetName() == "walls")
-		{
-			noed->GetComponent<RigidBody>()->SetLinearVelocity(Vector3::ZERO);
-			noed->GetComponent<RigidBodyMoveTo>()->isMoving_ = false;
-			noed->SetVar("Fired", false);
+		return;
+	}
 
-			arrowHitWall_->GetComponent<SoundSource>()->Play(arrowHitWall_->GetComponent<SoundSource>()->GetSound());
-		}
-		else if ( (otherNode->GetName() == "pet1"
-				|| otherNode->GetName() == "pet2"
-						|| otherNode->GetName() == "pet3"
-								|| otherNode->GetName() == "pet4") && noed->GetVar("Fired").GetBool())
-		{
-			spawnedMonsters_.Remove(otherNode);
-			otherNode->RemoveAllComponents();
-			otherNode->RemoveAllChildren();
-			otherNode->Remove();
-			monsterCount_--;
+	if (!monsters_.Remove(monster))//Already hit by another arrow this step.
+	{
+		return;
+	}
 
-			score_++;
+	monsterPool_.Release(monster);
+	monsterCount_--;
 
-			scoreText_->GetComponent<Text3D>()->SetText("The Score " + String( score_ ));
-			scoreText_->GetComponent<Text3D>()->SetWidth(12);
-			scoreText_->ApplyAttributes();
+	score_++;
 
-			if (score_ > topScore_->GetVar("TopScore").GetInt())
-			{
-				topScore_->SetVar("TopScore", score_);
-				topScoreText_->GetComponent<Text3D>()->SetText("Top Score " + String( topScore_->GetVar("TopScore").GetInt() ));
-				topScoreText_->GetComponent<Text3D>()->SetWidth(12);
-				topScoreText_->ApplyAttributes();
-			}
+	scoreHud_.SetScore(score_);
 
-			arrowHitDog_->GetComponent<SoundSource>()->Play(arrowHitDog_->GetComponent<SoundSource>()->GetSound());
-		}
+	if (score_ > topScore_->GetVar("TopScore").GetInt())
+	{
+		topScore_->SetVar("TopScore", score_);
+		scoreHud_.SetTopScore(score_);
 	}
+
+	PlaySound(arrowHitDog_);
 }
 
 void Gameplay::HandleKeyDown(StringHash eventType, VariantMap& eventData)
 {
 	using namespace KeyDown;
+
 	int key = eventData[P_KEY].GetInt();
 
-	if (key == KEY_W)//up
+	//Saving the trace is not part of the game, keep it out of the input log.
+	if (key == KEY_F12)
+	{
+		SaveTrace();
+		return;
+	}
+
+	QueueInput(INPUT_KEYDOWN, key, NO_CELL);
+}
+
+void Gameplay::HandleKeyUp(StringHash eventType, VariantMap& eventData)
+{
+	using namespace KeyUp;
+
+	QueueInput(INPUT_KEYUP, eventData[P_KEY].GetInt(), NO_CELL);
+}
+
+void Gameplay::QueueInput(InputType type, int value, int cell)
+{
+	if (inputLog_.IsReplaying())
+	{
+		return;
+	}
+
+	InputCommand command;
+	command.tick_ = physicsTick_;
+	command.type_ = type;
+	command.value_ = value;
+	command.cell_ = cell;
+	pendingInputs_.Push(command);
+}
+
+void Gameplay::ApplyInputs()
+{
+	TRACE("ApplyInputs");
+
+	//Inputs take effect at the start of a tick so a replay can apply them on the same tick.
+	InputCommand command;
+
+	if (inputLog_.IsReplaying())
 	{
-		wDown_ = true;
+		while (inputLog_.PopReplay(physicsTick_, command))
+		{
+			ApplyInput(command);
+		}
+
+		return;
 	}
-	else if (key == KEY_A)//left
+
+	for (unsigned x = 0; x < pendingInputs_.Size(); x++)
 	{
-		aDown_ = true;
+		command = pendingInputs_[x];
+		command.tick_ = physicsTick_;
+		inputLog_.Record(command);
+		ApplyInput(command);
 	}
-	else if (key == KEY_S)//down
+
+	pendingInputs_.Clear();
+}
+
+void Gameplay::ApplyInput(const InputCommand& command)
+{
+	int key = command.value_;
+
+	if (command.type_ == INPUT_KEYDOWN)
 	{
-		sDown_ = true;
+		if (key == KEY_W)//up
+		{
+			wDown_ = true;
+		}
+		else if (key == KEY_A)//left
+		{
+			aDown_ = true;
+		}
+		else if (key == KEY_S)//down
+		{
+			sDown_ = true;
+		}
+		else if (key == KEY_D)//right
+		{
+			dDown_ = true;
+		}
+		else if (key == KEY_SPACE)//projectile
+		{
+			ShootArrow();
+		}
+		else  if (key == KEY_ESC)
+		{
+			scoreStore_.Shutdown();
+			inputLog_.Close(physicsTick_);
+			SaveTrace();
+			main_->GetSubsystem<Engine>()->Exit();
+		}
 	}
-	else if (key == KEY_D)//right
+	else if (command.type_ == INPUT_KEYUP)
 	{
-		dDown_ = true;
+		if (key == KEY_W)//up
+		{
+			wDown_ = false;
+		}
+		else if (key == KEY_A)//left
+		{
+			aDown_ = false;
+		}
+		else if (key == KEY_S)//down
+		{
+			sDown_ = false;
+		}
+		else if (key == KEY_D)//right
+		{
+			dDown_ = false;
+		}
 	}
-	else if (key == KEY_SPACE)//projectile
+	else if (command.type_ == INPUT_MOUSEDOWN)
 	{
-		ShootArrow();
+		if (key & MOUSEB_LEFT)
+		{
+			XorInnerGates(command.cell_);
+		}
+
+		if (key & MOUSEB_RIGHT)
+		{
+			XorOuterGates(command.cell_);
+		}
 	}
-	else  if (key == KEY_ESC)
+	else if (command.type_ == INPUT_END)
 	{
+		LOGINFOF("Replay finished after %u ticks, score %d", physicsTick_, score_);
+		scoreStore_.Shutdown();
+		SaveTrace();
 		main_->GetSubsystem<Engine>()->Exit();
 	}
 }
 
-void Gameplay::HandleKeyUp(StringHash eventType, VariantMap& eventData)
+void Gameplay::SaveTrace()
 {
-	using namespace KeyUp;
-	int key = eventData[P_KEY].GetInt();
+	if (TraceRecorder::IsEnabled() && TraceRecorder::Export(context_, main_->tracePath_))
+	{
+		LOGINFO("Trace saved to " + main_->tracePath_);
+	}
+}
+
+void Gameplay::PlaySound(Node* soundNode)
+{
+	if (main_->headless_)
+	{
+		return;
+	}
+
+	SoundSource* soundSource = soundNode->GetComponent<SoundSource>();
+	soundSource->Play(soundSource->GetSound());
+}
 
-	if (key == KEY_W)//up
+void Gameplay::TagEntities()
+{
+	//Names are compared once here, collisions only look at the category.
+	static const struct
+	{
+		const char* name_;
+		EntityCategory category_;
+	} categoryNames[] =
 	{
-		wDown_ = false;
+		{ "archer", CATEGORY_ARCHER },
+		{ "pet1", CATEGORY_MONSTER },
+		{ "pet2", CATEGORY_MONSTER },
+		{ "pet3", CATEGORY_MONSTER },
+		{ "pet4", CATEGORY_MONSTER },
+		{ "quartz", CATEGORY_ARROW },
+		{ "elf", CATEGORY_ELF },
+		{ "chest", CATEGORY_CHEST },
+		{ "potion", CATEGORY_POTION },
+		{ "walls", CATEGORY_WALL }
+	};
+
+	PODVector<Node*> nodes;
+	scene_->GetChildren(nodes, true);
+
+	for (unsigned x = 0; x < nodes.Size(); x++)
+	{
+		for (unsigned y = 0; y < sizeof(categoryNames) / sizeof(categoryNames[0]); y++)
+		{
+			if (nodes[x]->GetName() == categoryNames[y].name_)
+			{
+				SetEntityCategory(nodes[x], categoryNames[y].category_);
+				break;
+			}
+		}
 	}
-	else if (key == KEY_A)//left
+}
+
+void Gameplay::DeclareCollisionLayers()
+{
+	collisionMatrix_.enabled_ = main_->gameplayConfig_.collisionLayers_;
+
+	collisionMatrix_.Allow(LAYER_ARCHER, LAYER_FLOOR);
+	collisionMatrix_.Allow(LAYER_ARCHER, LAYER_GATE);
+	collisionMatrix_.Allow(LAYER_ARCHER, LAYER_MONSTER);
+	collisionMatrix_.Allow(LAYER_ARCHER, LAYER_ARROW);
+	collisionMatrix_.Allow(LAYER_ARCHER, LAYER_PICKUP);
+	collisionMatrix_.Allow(LAYER_MONSTER, LAYER_FLOOR);
+	collisionMatrix_.Allow(LAYER_MONSTER, LAYER_GATE);
+	collisionMatrix_.Allow(LAYER_MONSTER, LAYER_ARROW);
+	collisionMatrix_.Allow(LAYER_ARROW, LAYER_GATE);
+	collisionMatrix_.Allow(LAYER_PICKUP, LAYER_FLOOR);
+
+	//Arrows only need the floor to lie on when they fall.
+	Node* arrow = scene_->GetChild("quartz");
+	RigidBody* arrowBody = arrow ? arrow->GetComponent<RigidBody>() : 0;
+
+	if (arrowBody && arrowBody->GetUseGravity())
 	{
-		aDown_ = false;
+		collisionMatrix_.Allow(LAYER_ARROW, LAYER_FLOOR);
 	}
-	else if (key == KEY_S)//down
+}
+
+void Gameplay::ApplyCollisionLayers()
+{
+	collisionMatrix_.Apply(archerHandles_.body_, LAYER_ARCHER);
+	collisionMatrix_.Apply(scene_->GetChild("walls"), LAYER_GATE);
+
+	for (int x = 0; x < mazeGrid_.GetNumCells(); x++)
 	{
-		sDown_ = false;
+		collisionMatrix_.Apply(mazeGrid_.GetCell(x), LAYER_FLOOR);
+
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
+		{
+			collisionMatrix_.Apply(cellHandles_[x].gates_[y].body_, LAYER_GATE);
+		}
 	}
-	else if (key == KEY_D)//right
+}
+
+void Gameplay::SampleContactPairs()
+{
+	btDiscreteDynamicsWorld* world = scene_->GetComponent<PhysicsWorld>()->GetWorld();
+
+	stats_.broadphasePairs_ += world->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
+	stats_.contactManifolds_ += world->getDispatcher()->getNumManifolds();
+	stats_.pairSamples_++;
+}
+
+void Gameplay::ResolveHandles()
+{
+	archerHandles_.Resolve(archer_);
+
+	cellHandles_.Resize(mazeGrid_.GetNumCells());
+
+	for (int x = 0; x < mazeGrid_.GetNumCells(); x++)
 	{
-		dDown_ = false;
+		cellHandles_[x].Resolve(mazeGrid_.GetCell(x));
 	}
 }
 
 void Gameplay::MoveArcher()
 {
+	TRACE("MoveArcher");
+
 	Quaternion rot = archer_->GetRotation();
 	Vector3 moveDir = Vector3::ZERO;
 
 	if (wDown_)
 	{
 		moveDir += Vector3::FORWARD;
-		archer_->GetChild("archer")->SetRotation(Quaternion(45.0f, 0.0f, 0.0f));
+		archerHandles_.node_->SetRotation(Quaternion(45.0f, 0.0f, 0.0f));
 		archerDir_ = 0;
 	}
 	else if (sDown_)
 	{
 		moveDir += Vector3::BACK;
-		archer_->GetChild("archer")->SetRotation(Quaternion(-45.0f, 180.0f, 0.0f));
+		archerHandles_.node_->SetRotation(Quaternion(-45.0f, 180.0f, 0.0f));
 		archerDir_ = 1;
 	}
 
 	if (aDown_)
 	{
 		moveDir += Vector3::LEFT;
-		archer_->GetChild("archer")->SetRotation(Quaternion(0.0f, -90.0f, -45.0f));
+		archerHandles_.node_->SetRotation(Quaternion(0.0f, -90.0f, -45.0f));
 		archerDir_ = 2;
 	}
 	else if (dDown_)
 	{
 		moveDir += Vector3::RIGHT;
-		archer_->GetChild("archer")->SetRotation(Quaternion(0.0f, 90.0f, 45.0f));
+		archerHandles_.node_->SetRotation(Quaternion(0.0f, 90.0f, 45.0f));
 		archerDir_ = 3;
 	}
 
@@ -523,23 +885,23 @@ void Gameplay::MoveArcher()
 
 	if (moveDir == Vector3::ZERO)
 	{
-		if (!archer_->GetChild("archer")->GetComponent<AnimationController>()->IsPlaying("Models/archerIdle.ani")
-				&& !archer_->GetChild("archer")->GetComponent<AnimationController>()->IsPlaying("Models/archerAttack.ani"))
+		if (!archerHandles_.animation_->IsPlaying("Models/archerIdle.ani")
+				&& !archerHandles_.animation_->IsPlaying("Models/archerAttack.ani"))
 		{
-			RecursiveAnimate(archer_->GetChild("archer"), "Models/archerIdle.ani", 0, true, 0.0f, true, 1.0f);
+			RecursiveAnimate(archerHandles_.node_, "Models/archerIdle.ani", 0, true, 0.0f, true, 1.0f);
 		}
 
-		archer_->GetChild("archer")->GetComponent<RigidBody>()->SetLinearVelocity(Vector3::ZERO);
+		archerHandles_.body_->SetLinearVelocity(Vector3::ZERO);
 		return;
 	}
 
-	if (!archer_->GetChild("archer")->GetComponent<AnimationController>()->IsPlaying("archerRun1")
-			&& !archer_->GetChild("archer")->GetComponent<AnimationController>()->IsPlaying("Models/archerAttack.ani"))
+	if (!archerHandles_.animation_->IsPlaying("archerRun1")
+			&& !archerHandles_.animation_->IsPlaying("Models/archerAttack.ani"))
 	{
-		RecursiveAnimate(archer_->GetChild("archer"), "Models/archerRun1.ani", 0, true, 0.0f, true, 1.0f);
+		RecursiveAnimate(archerHandles_.node_, "Models/archerRun1.ani", 0, true, 0.0f, true, 1.0f);
 	}
 
-	archer_->GetChild("archer")->GetComponent<RigidBody>()->SetLinearVelocity((rot * moveDir) * archerSpeed_);
+	archerHandles_.body_->SetLinearVelocity((rot * moveDir) * archerSpeed_);
 }
 
 void Gameplay::RecursiveAnimate(Node* noed, String animation, char layer, bool loop, float fadeTime, bool exclusive, float speed)
@@ -569,1484 +931,548 @@ void Gameplay::RecursiveAnimate(Node* noed, String animation, char layer, bool l
 	}
 }
 
-void Gameplay::RandomizeGates()
+void Gameplay::LoadGates()
 {
-	closedCells_.Clear();
-	openCells_.Clear();
-
-	PODVector<StaticModel*> components;
+	gateBoard_.Resize(mazeGrid_.width_, mazeGrid_.height_);
+	gateBoard_.Fill(GATE_MASK_ALL);
 
-	BoundingBox archerBB = archer_->GetChild("archer")->
-			GetComponent<CollisionShape>()->GetWorldBoundingBox();
-
-	for (int x = 0; x < cells_->GetNumChildren(); x++)
+	for (int x = 0; x < mazeGrid_.GetNumCells(); x++)
 	{
-		components.Clear();
-		if ( cells_->GetChild(x)->GetChild("closedTop")->GetComponent<CollisionShape>()->
-				GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
+		if (!cellHandles_[x].IsValid())
 		{
-			cells_->GetChild(x)->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			cells_->GetChild(x)->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
+			continue;
 		}
 
-		components.Clear();
-		if ( cells_->GetChild(x)->GetChild("closedBottom")->GetComponent<CollisionShape>()->
-				GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
 		{
-			cells_->GetChild(x)->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			cells_->GetChild(x)->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
+			RigidBody* body = cellHandles_[x].gates_[y].body_;
 
-		components.Clear();
-		if ( cells_->GetChild(x)->GetChild("closedLeft")->GetComponent<CollisionShape>()->
-				GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-		{
-			cells_->GetChild(x)->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			cells_->GetChild(x)->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
-
-		components.Clear();
-		if ( cells_->GetChild(x)->GetChild("closedRight")->GetComponent<CollisionShape>()->
-				GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-		{
-			cells_->GetChild(x)->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			cells_->GetChild(x)->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
-
-		closedCells_.Push(cells_->GetChild(x));
-	}
-
-	for (int x = 0; x < cells_->GetNumChildren() * 0.5f; x++)
-	{
-		Node* cell = closedCells_[Random(0, closedCells_.Size())];
-		openCells_.Push(cell);
-		closedCells_.Remove(cell);
-	}
-
-	//Disabling/Enabling a CollisionShape during collision crashes.  Turn to trigger instead.
-
-	for (int x = 0; x < closedCells_.Size(); x++)
-	{
-		//Top
-		components.Clear();
-		closedCells_[x]->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-		if (Random(0,2))
-		{
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//closedCells_[x]->GetChild("closedTop")->GetComponent<CollisionShape>()->SetEnabled(false);
-			closedCells_[x]->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			if ( closedCells_[x]->GetChild("closedTop")->GetComponent<CollisionShape>()->
-					GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
+			//A gate without a body has nothing to read, it stays closed like the rest of the fill.
+			if (body)
 			{
-				components[0]->SetEnabled(true);
-				components[1]->SetEnabled(false);
-				//closedCells_[x]->GetChild("closedTop")->GetComponent<CollisionShape>()->SetEnabled(true);
-				closedCells_[x]->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
+				gateBoard_.SetClosed(x, (CellSide)y, !body->IsTrigger());
 			}
-		}
 
-		//Bottom
-		components.Clear();
-		closedCells_[x]->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-		if (Random(0,2))
-		{
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//closedCells_[x]->GetChild("closedBottom")->GetComponent<CollisionShape>()->SetEnabled(false);
-			closedCells_[x]->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			if ( closedCells_[x]->GetChild("closedBottom")->GetComponent<CollisionShape>()->
-					GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-			{
-				components[0]->SetEnabled(true);
-				components[1]->SetEnabled(false);
-				//closedCells_[x]->GetChild("closedBottom")->GetComponent<CollisionShape>()->SetEnabled(true);
-				closedCells_[x]->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-			}
-		}
+			//The gates MazeBuilder made the edge of the maze are its walls, they never open.
+			Node* gate = cellHandles_[x].gates_[y].node_;
 
-		//Left
-		components.Clear();
-		closedCells_[x]->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-		if (Random(0,2))
-		{
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//closedCells_[x]->GetChild("closedLeft")->GetComponent<CollisionShape>()->SetEnabled(false);
-			closedCells_[x]->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			if ( closedCells_[x]->GetChild("closedLeft")->GetComponent<CollisionShape>()->
-					GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
+			if (gate && GetEntityCategory(gate) == CATEGORY_WALL)
 			{
-				components[0]->SetEnabled(true);
-				components[1]->SetEnabled(false);
-				//closedCells_[x]->GetChild("closedLeft")->GetComponent<CollisionShape>()->SetEnabled(true);
-				closedCells_[x]->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
-			}
-		}
+				gateBoard_.SetFixed(x, (CellSide)y);
 
-		//Right
-		components.Clear();
-		closedCells_[x]->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-		if (Random(0,2))
-		{
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//closedCells_[x]->GetChild("closedRight")->GetComponent<CollisionShape>()->SetEnabled(false);
-			closedCells_[x]->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			if ( closedCells_[x]->GetChild("closedRight")->GetComponent<CollisionShape>()->
-					GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-			{
-				components[0]->SetEnabled(true);
-				components[1]->SetEnabled(false);
-				//closedCells_[x]->GetChild("closedRight")->GetComponent<CollisionShape>()->SetEnabled(true);
-				closedCells_[x]->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
+				if (body && body->IsTrigger())
+				{
+					ApplyGate(x, (CellSide)y);
+				}
 			}
 		}
 	}
 
-	for (int x = 0; x < openCells_.Size(); x++)
-	{
-		components.Clear();
-		if (Random(0,2))//Top
-		{
-			openCells_[x]->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//openCells_[x]->GetChild("closedTop")->GetComponent<CollisionShape>()->SetEnabled(false);
-			openCells_[x]->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else//Bottom
-		{
-			openCells_[x]->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//openCells_[x]->GetChild("closedBottom")->GetComponent<CollisionShape>()->SetEnabled(false);
-			openCells_[x]->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-
-		components.Clear();
-		if (Random(0,2))//Left
-		{
-			openCells_[x]->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//openCells_[x]->GetChild("closedLeft")->GetComponent<CollisionShape>()->SetEnabled(false);
-			openCells_[x]->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else//Right
-		{
-			openCells_[x]->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			//openCells_[x]->GetChild("closedRight")->GetComponent<CollisionShape>()->SetEnabled(false);
-			openCells_[x]->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-	}
-
-	gateOpen_->GetComponent<SoundSource>()->Play(gateOpen_->GetComponent<SoundSource>()->GetSound());
+	gateSync_.Reset(gateBoard_);
+	gateBoard_.ClearDirty();
 }
 
-
-void Gameplay::HandleMouseDown(StringHash eventType, VariantMap& eventData)
+void Gameplay::ApplyGate(int index, CellSide side)
 {
-	using namespace MouseButtonDown;
-	int butts = eventData[P_BUTTONS].GetInt();
+	GateHandles& gate = cellHandles_[index].gates_[side];
+	bool closed = gateBoard_.IsClosed(index, side);
 
-	if (butts & MOUSEB_LEFT)
+	if (mazeRenderer_.IsBuilt())
 	{
-		XorInnerGates();
+		mazeRenderer_.SetGateClosed(index, side, closed);
 	}
-
-	if (butts & MOUSEB_RIGHT)
+	else if (gate.closedModel_ && gate.openModel_)
 	{
-		XorOuterGates();
+		gate.closedModel_->SetEnabled(closed);
+		gate.openModel_->SetEnabled(!closed);
 	}
-}
-
-void Gameplay::XorInnerGates()
-{
-	PODVector<StaticModel*> components;
-
-	BoundingBox archerBB = archer_->GetChild("archer")->
-			GetComponent<CollisionShape>()->GetWorldBoundingBox();
-
-	PODVector<PhysicsRaycastResult> raeResult;
-
-	Ray mouseRay = cameraNode_->GetComponent<Camera>()->GetScreenRay(
-			(float) main_->input_->GetMousePosition().x_ / main_->graphics_->GetWidth(),
-			(float) main_->input_->GetMousePosition().y_ / main_->graphics_->GetHeight());
-
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, mouseRay, 1000.0f);
 
-	for (int x = 0; x < raeResult.Size(); x++)
+	//Gates only change from the pre-step, never inside a collision handler, so compound shapes can be toggled.
+	if (mazeColliders_.SetGateClosed(index, side, closed))
 	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			Node* targCell = raeResult[x].body_->GetNode();
-
-			Ray archerRay;
-			archerRay.origin_ = archer_->GetChild("archer")->GetComponent<RigidBody>()->GetPosition();
-			archerRay.direction_ = Vector3::DOWN;
-
-			PODVector<PhysicsRaycastResult> raeResult2;
-
-			scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult2, archerRay, 1000.0f);
-
-			for (int y = 0; y < raeResult2.Size(); y++)
-			{
-				if (raeResult2[y].body_->GetNode()->GetName() == "cell")
-				{
-					Node* destCell = raeResult2[y].body_->GetNode();
-
-					bool isDestTrigger, isTargTrigger, destXor, targXor;
-
-					//Top
-					isDestTrigger = destCell->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger();
-					isTargTrigger = targCell->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger();
-
-					destXor = isDestTrigger ^ isTargTrigger;
-					targXor = isTargTrigger ^ destXor;
-
-					components.Clear();
-					if (destXor)
-					{
-						destCell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						destCell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( destCell->GetChild("closedTop")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							destCell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							destCell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					components.Clear();
-					if (targXor)
-					{
-						targCell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						targCell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( targCell->GetChild("closedTop")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							targCell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							targCell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					//Bottom
-					isDestTrigger = destCell->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger();
-					isTargTrigger = targCell->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger();
-
-					destXor = isDestTrigger ^ isTargTrigger;
-					targXor = isTargTrigger ^ destXor;
-
-					components.Clear();
-					if (destXor)
-					{
-						destCell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						destCell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( destCell->GetChild("closedBottom")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							destCell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							destCell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					components.Clear();
-					if (targXor)
-					{
-						targCell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						targCell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( targCell->GetChild("closedBottom")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							targCell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							targCell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					//Left
-					isDestTrigger = destCell->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger();
-					isTargTrigger = targCell->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger();
-
-					destXor = isDestTrigger ^ isTargTrigger;
-					targXor = isTargTrigger ^ destXor;
-
-					components.Clear();
-					if (destXor)
-					{
-						destCell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						destCell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( destCell->GetChild("closedLeft")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							destCell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							destCell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					components.Clear();
-					if (targXor)
-					{
-						targCell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						targCell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( targCell->GetChild("closedLeft")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							targCell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							targCell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					//Right
-					isDestTrigger = destCell->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger();
-					isTargTrigger = targCell->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger();
-
-					destXor = isDestTrigger ^ isTargTrigger;
-					targXor = isTargTrigger ^ destXor;
-
-					components.Clear();
-					if (destXor)
-					{
-						destCell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						destCell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( destCell->GetChild("closedRight")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							destCell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							destCell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					components.Clear();
-					if (targXor)
-					{
-						targCell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-						components[0]->SetEnabled(false);
-						components[1]->SetEnabled(true);
-						targCell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-					}
-					else
-					{
-						if ( targCell->GetChild("closedRight")->GetComponent<CollisionShape>()->
-								GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-						{
-							targCell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-							components[0]->SetEnabled(true);
-							components[1]->SetEnabled(false);
-							targCell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
-						}
-					}
-
-					break;
-				}
-			}
-
-			break;
-		}
+		return;
 	}
 
-	gateOpen_->GetComponent<SoundSource>()->Play(gateOpen_->GetComponent<SoundSource>()->GetSound());
+	//Disabling/Enabling a CollisionShape during collision crashes.  Turn to trigger instead.
+	if (gate.body_)
+	{
+		gate.body_->SetTrigger(!closed);
+	}
 }
 
-void Gameplay::XorOuterGates()
+void Gameplay::SyncGates()
 {
-	Node* destCell = NULL;
-	Node* destCellUp = NULL;
-	Node* destCellDown = NULL;
-	Node* destCellLeft = NULL;
-	Node* destCellRight = NULL;
-	Node* targCell = NULL;
-	Node* targCellUp = NULL;
-	Node* targCellDown = NULL;
-	Node* targCellLeft = NULL;
-	Node* targCellRight = NULL;
-
-	PODVector<StaticModel*> components;
+	TRACE("SyncGates");
 
-	bool isDestTrigger, isTargTrigger, destXor, targXor;
-
-	PODVector<PhysicsRaycastResult> raeResult;
-
-	Ray mouseRay = cameraNode_->GetComponent<Camera>()->GetScreenRay(
-			(float) main_->input_->GetMousePosition().x_ / main_->graphics_->GetWidth(),
-			(float) main_->input_->GetMousePosition().y_ / main_->graphics_->GetHeight());
+	gateSync_.Collect(gateBoard_, changedGates_);
 
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, mouseRay, 1000.0f);
+	stats_.gateSyncs_++;
+	stats_.gatesTouched_ += gateSync_.GetLastTouched();
 
-	for (int x = 0; x < raeResult.Size(); x++)
+	for (unsigned x = 0; x < changedGates_.Size(); x++)
 	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			targCell = raeResult[x].body_->GetNode();
-			break;
-		}
+		ApplyGate(changedGates_[x] / MAX_CELL_SIDES, (CellSide)(changedGates_[x] % MAX_CELL_SIDES));
 	}
 
-	if (!targCell){return;}
+	mazeColliders_.Flush();
 
-	Ray archerRay;
-	archerRay.origin_ = archer_->GetChild("archer")->GetComponent<RigidBody>()->GetPosition();
-	archerRay.direction_ = Vector3::DOWN;
-
-	raeResult.Clear();
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, archerRay, 1000.0f);
-
-	for (int y = 0; y < raeResult.Size(); y++)
+	if (changedGates_.Size() > 0)
 	{
-		if (raeResult[y].body_->GetNode()->GetName() == "cell")
-		{
-			destCell = raeResult[y].body_->GetNode();
-			break;
-		}
+		TrimMonsterPaths();
 	}
 
-	if (!destCell){return;}
-
-	Ray rae;
+	UpdateFlowField(changedGates_.Size() > 0);
+}
 
-	Vector3 cellSize = targCell->GetComponent<CollisionShape>()->GetSize();
+void Gameplay::GetArcherGates(PODVector<int>& gates)
+{
+	gates.Clear();
 
-	//Top (In the scene, the cells are Top=Right, Bottom=Left, Left=Top, Right=Bottom,
-	raeResult.Clear();
-	rae.origin_ = targCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(0.0f, 1.0f, cellSize.z_);
-	rae.direction_ = Vector3::DOWN;
+	BoundingBox archerBB = archerHandles_.shape_->GetWorldBoundingBox();
 
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+	int archerIndex = mazeGrid_.GetCellIndex(archerBB.Center());
 
-	for (int x = 0; x < raeResult.Size(); x++)
+	if (archerIndex == NO_CELL)
 	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			targCellUp = raeResult[x].body_->GetNode();
-			break;
-		}
+		return;
 	}
 
-	raeResult.Clear();
-	rae.origin_ = destCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(0.0f, 1.0f, cellSize.z_);
-	rae.direction_ = Vector3::DOWN;
-
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+	//The archer can only overlap gates of its own cell and the cells around it.
+	int cells[] = {archerIndex,
+			mazeGrid_.GetNeighbour(archerIndex, SIDE_TOP),
+			mazeGrid_.GetNeighbour(archerIndex, SIDE_BOTTOM),
+			mazeGrid_.GetNeighbour(archerIndex, SIDE_LEFT),
+			mazeGrid_.GetNeighbour(archerIndex, SIDE_RIGHT)};
 
-	for (int x = 0; x < raeResult.Size(); x++)
+	for (int x = 0; x < 5; x++)
 	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
+		if (cells[x] == NO_CELL)
 		{
-			destCellUp = raeResult[x].body_->GetNode();
-			break;
+			continue;
 		}
-	}
-
-	if (destCellUp && targCellUp)
-	{
-		isDestTrigger = destCellUp->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger();
-		isTargTrigger = targCellUp->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger();
 
-		destXor = isDestTrigger ^ isTargTrigger;
-		targXor = isTargTrigger ^ destXor;
-
-		components.Clear();
-		if (destXor)
-		{
-			destCellUp->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			destCellUp->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
 		{
-			destCellUp->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			destCellUp->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
+			CellSide side = (CellSide)y;
 
-		components.Clear();
-		if (targXor)
-		{
-			targCellUp->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			targCellUp->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			targCellUp->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			targCellUp->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
+			if (!gateBoard_.IsClosed(cells[x], side)
+					&& mazeGrid_.GetGateBounds(cells[x], side).IsInside(archerBB) != OUTSIDE)
+			{
+				gates.Push(cells[x] * MAX_CELL_SIDES + side);
+			}
 		}
 	}
+}
 
-	//Bottom (In the scene, the cells are Top=Right, Bottom=Left, Left=Top, Right=Bottom,
-	raeResult.Clear();
-	rae.origin_ = targCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(0.0f, 1.0f, -cellSize.z_);
-	rae.direction_ = Vector3::DOWN;
-
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
-
-	for (int x = 0; x < raeResult.Size(); x++)
+void Gameplay::ReopenGates(const PODVector<int>& gates)
+{
+	for (unsigned x = 0; x < gates.Size(); x++)
 	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
+		int index = gates[x] / MAX_CELL_SIDES;
+		CellSide side = (CellSide)(gates[x] % MAX_CELL_SIDES);
+
+		if (gateBoard_.IsClosed(index, side) && !gateBoard_.IsFixed(index, side))
 		{
-			targCellDown = raeResult[x].body_->GetNode();
-			break;
+			gateBoard_.SetClosed(index, side, false);
 		}
 	}
+}
 
-	raeResult.Clear();
-	rae.origin_ = destCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(0.0f, 1.0f, -cellSize.z_);
-	rae.direction_ = Vector3::DOWN;
+void Gameplay::XorGates(int destIndex, int targIndex, unsigned sides)
+{
+	//Walls take no part in the swap, an open gate traded onto one would be lost.
+	sides &= ~(gateBoard_.GetFixedMask(destIndex) | gateBoard_.GetFixedMask(targIndex));
 
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+	unsigned dest = gateBoard_.GetMask(destIndex) & sides;
+	unsigned targ = gateBoard_.GetMask(targIndex) & sides;
 
-	for (int x = 0; x < raeResult.Size(); x++)
+	//A gate is open when its bit is clear, so the dest gate opens when exactly one of the pair was open,
+	//which is flipping it where the targ gate is open. The targ gate then takes the dest gate's previous state.
+	gateBoard_.XorMask(destIndex, ~targ & sides);
+	gateBoard_.XorMask(targIndex, (gateBoard_.GetMask(targIndex) ^ dest) & sides);
+}
+
+bool Gameplay::StealGate(int index, CellSide side)
+{
+	if (!gateBoard_.IsClosed(index, side))
 	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			destCellDown = raeResult[x].body_->GetNode();
-			break;
-		}
+		return true;
 	}
 
-	if (targCellDown && destCellDown)
+	if (gateBoard_.IsFixed(index, side))
 	{
-		isDestTrigger = destCellDown->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger();
-		isTargTrigger = targCellDown->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger();
+		return false;
+	}
 
-		destXor = isDestTrigger ^ isTargTrigger;
-		targXor = isTargTrigger ^ destXor;
+	int donor = gateBoard_.FindOpen(side);
 
-		components.Clear();
-		if (destXor)
-		{
-			destCellDown->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			destCellDown->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			destCellDown->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			destCellDown->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
-
-		components.Clear();
-		if (targXor)
-		{
-			targCellDown->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			targCellDown->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			targCellDown->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			targCellDown->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
+	if (donor == NO_CELL)
+	{
+		return false;
 	}
 
-	//Left (In the scene, the cells are Top=Right, Bottom=Left, Left=Top, Right=Bottom,
-	raeResult.Clear();
-	rae.origin_ = targCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(-cellSize.x_, 1.0f, 0.0f);
-	rae.direction_ = Vector3::DOWN;
+	gateBoard_.SetClosed(index, side, false);
+	gateBoard_.SetClosed(donor, side, true);
 
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+	return true;
+}
 
-	for (int x = 0; x < raeResult.Size(); x++)
-	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			targCellLeft = raeResult[x].body_->GetNode();
-			break;
-		}
-	}
+void Gameplay::RandomizeGates()
+{
+	TRACE("RandomizeGates");
 
-	raeResult.Clear();
-	rae.origin_ = destCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(-cellSize.x_, 1.0f, 0.0f);
-	rae.direction_ = Vector3::DOWN;
+	PODVector<int> archerGates;
+	GetArcherGates(archerGates);
 
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+	mazeGenerator_.Generate(mazeGrid_, gateBoard_, mazeSeed_ + mazeGeneration_);
+	mazeGeneration_++;
 
-	for (int x = 0; x < raeResult.Size(); x++)
-	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			destCellLeft = raeResult[x].body_->GetNode();
-			break;
-		}
-	}
+	ReopenGates(archerGates);
 
-	if (destCellLeft && targCellLeft)
-	{
-		isDestTrigger = destCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger();
-		isTargTrigger = targCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger();
+	PlaySound(gateOpen_);
+}
 
-		destXor = isDestTrigger ^ isTargTrigger;
-		targXor = isTargTrigger ^ destXor;
 
-		components.Clear();
-		if (destXor)
-		{
-			destCellLeft->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			destCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			destCellLeft->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			destCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
+void Gameplay::HandleMouseDown(StringHash eventType, VariantMap& eventData)
+{
+	using namespace MouseButtonDown;
+	int butts = eventData[P_BUTTONS].GetInt();
 
-		components.Clear();
-		if (targXor)
-		{
-			targCellLeft->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			targCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			targCellLeft->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			targCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
-	}
+	//The cell under the cursor is picked now, the gates flip on the next tick and a replay needs no camera.
+	Ray mouseRay = cameraNode_->GetComponent<Camera>()->GetScreenRay(
+			(float) main_->input_->GetMousePosition().x_ / main_->graphics_->GetWidth(),
+			(float) main_->input_->GetMousePosition().y_ / main_->graphics_->GetHeight());
 
-	//Right (In the scene, the cells are Top=Right, Bottom=Left, Left=Top, Right=Bottom,
-	raeResult.Clear();
-	rae.origin_ = targCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(cellSize.x_, 1.0f, 0.0f);
-	rae.direction_ = Vector3::DOWN;
+	QueueInput(INPUT_MOUSEDOWN, butts, mazeGrid_.PickCell(mouseRay));
+}
 
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+void Gameplay::XorInnerGates(int targIndex)
+{
+	int destIndex = mazeGrid_.GetCellIndex(archerHandles_.body_->GetPosition());
 
-	for (int x = 0; x < raeResult.Size(); x++)
+	if (targIndex != NO_CELL && destIndex != NO_CELL)
 	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			targCellRight = raeResult[x].body_->GetNode();
-			break;
-		}
+		PODVector<int> archerGates;
+		GetArcherGates(archerGates);
+
+		XorGates(destIndex, targIndex, GATE_MASK_ALL);
+
+		ReopenGates(archerGates);
 	}
 
-	raeResult.Clear();
-	rae.origin_ = destCell->GetComponent<RigidBody>()->GetPosition();
-	rae.origin_ += Vector3(cellSize.x_, 1.0f, 0.0f);
-	rae.direction_ = Vector3::DOWN;
+	PlaySound(gateOpen_);
+}
 
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+void Gameplay::XorOuterGates(int targIndex)
+{
+	if (targIndex == NO_CELL){return;}
 
-	for (int x = 0; x < raeResult.Size(); x++)
-	{
-		if (raeResult[x].body_->GetNode()->GetName() == "cell")
-		{
-			destCellRight = raeResult[x].body_->GetNode();
-			break;
-		}
-	}
+	int destIndex = mazeGrid_.GetCellIndex(archerHandles_.body_->GetPosition());
 
-	if (destCellRight && targCellRight)
-	{
-		isDestTrigger = destCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger();
-		isTargTrigger = targCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger();
+	if (destIndex == NO_CELL){return;}
 
-		destXor = isDestTrigger ^ isTargTrigger;
-		targXor = isTargTrigger ^ destXor;
+	PODVector<int> archerGates;
+	GetArcherGates(archerGates);
 
-		components.Clear();
-		if (destXor)
-		{
-			destCellRight->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			destCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
-		{
-			destCellRight->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			destCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
-		}
+	//Swap the gates of the surrounding cells that face the dest and targ cells.
+	for (int x = 0; x < MAX_CELL_SIDES; x++)
+	{
+		CellSide side = (CellSide)x;
 
-		components.Clear();
-		if (targXor)
-		{
-			targCellRight->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(false);
-			components[1]->SetEnabled(true);
-			targCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-		}
-		else
+		int destNeighbour = mazeGrid_.GetNeighbour(destIndex, side);
+		int targNeighbour = mazeGrid_.GetNeighbour(targIndex, side);
+
+		if (destNeighbour != NO_CELL && targNeighbour != NO_CELL)
 		{
-			targCellRight->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-			components[0]->SetEnabled(true);
-			components[1]->SetEnabled(false);
-			targCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
+			XorGates(destNeighbour, targNeighbour, 1 << MazeGrid::GetOppositeSide(side));
 		}
 	}
 
-	gateOpen_->GetComponent<SoundSource>()->Play(gateOpen_->GetComponent<SoundSource>()->GetSound());
+	ReopenGates(archerGates);
+
+	PlaySound(gateOpen_);
 }
 
 void Gameplay::SpawnMonster()
 {
-	if (monsterCount_ >= monsterMax_){return;}
+	TRACE("SpawnMonster");
 
-	Node* archerCell;
-
-	PODVector<PhysicsRaycastResult> raeResult;
+	if (monsterCount_ >= monsterMax_){return;}
 
-	Ray archerRay;
-	archerRay.origin_ = archer_->GetChild("archer")->GetComponent<RigidBody>()->GetPosition();
-	archerRay.direction_ = Vector3::DOWN;
+	Node* archerCell = mazeGrid_.GetCell(mazeGrid_.GetCellIndex(
+			archerHandles_.body_->GetPosition()));
 
-	raeResult.Clear();
-	scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, archerRay, 1000.0f);
+	unsigned numCells = cells_->GetNumChildren();
 
-	for (int y = 0; y < raeResult.Size(); y++)
+	//No cell besides the archer's to put a pet in.
+	if (!numCells || (numCells < 2 && archerCell))
 	{
-		if (raeResult[y].body_->GetNode()->GetName() == "cell")
-		{
-			archerCell = raeResult[y].body_->GetNode();
-			break;
-		}
+		return;
 	}
 
-	Node* cell = cells_->GetChild(Random(0,cells_->GetNumChildren()));
+	unsigned pick = (unsigned)Random(0, (int)numCells);
+	Node* cell = cells_->GetChild(pick);
 
+	//Any cell but the archer's, taking the next one keeps it to a single pick.
 	if (archerCell == cell)
 	{
-		SpawnMonster();
-		return;
+		cell = cells_->GetChild((pick + 1) % numCells);
 	}
 
-	Node* monster = baseMonsters_[Random(0,4)]->Clone(LOCAL);
+	Node* monster = monsterPool_.Acquire(Random(0,4));
+	monsterPool_.TakeCounters(stats_.monsterPoolHits_, stats_.monsterPoolFallbacks_, stats_.monsterPoolMisses_);
+	Vector3 spawnPos = cell->GetPosition() + Vector3(0.0f, 6.0f, 0.0f);
+	CollisionShape* shape = monster->GetComponent<CollisionShape>();
 
-	spawnedMonsters_.Push(monster);
+	//Kinematic pets don't fall, put them straight onto the floor.
+	if (monsterPool_.kinematic_ && shape)
+	{
+		spawnPos.y_ = mazeGrid_.floorHeight_ + monster->GetWorldPosition().y_ - shape->GetWorldBoundingBox().min_.y_;
+	}
 
-	RigidBodyMoveTo* _RigidBodyMoveTo = new RigidBodyMoveTo(context_);
-	monster->AddComponent(_RigidBodyMoveTo, 0, LOCAL);
+	monster->SetPosition(spawnPos);
+	collisionMatrix_.Apply(monster, LAYER_MONSTER);
 
-	monsterCount_++;
+	monsters_.Add(monster);
 
-	monster->SetPosition(cell->GetPosition() + Vector3(0.0f, 6.0f, 0.0f));
+	monsterCount_++;
 }
 
 void Gameplay::MoveMonsters()
 {
-	PODVector<StaticModel*> components;
+	TRACE("MoveMonsters");
 
-	BoundingBox archerBB = archer_->GetChild("archer")->
-			GetComponent<CollisionShape>()->GetWorldBoundingBox();
+	monstersThought_ = 0;
 
-	bool isDestTrigger, isTargTrigger, destXor, targXor;
+	unsigned count = monsters_.Size();
 
-	if (monsterMoveTurn_ >= spawnedMonsters_.Size())
+	if (!count)
 	{
-		monsterMoveTurn_ = 0;
+		return;
 	}
 
-	Node* monster = spawnedMonsters_[monsterMoveTurn_];
+	monsters_.Gather(mazeGrid_);
 
-	//for (int x = 0; x < spawnedMonsters_.Size(); x++)//pets close each others gates.
-	if (monster)
-	{
-		monsterMoveTurn_++;
-		//Node* monster = spawnedMonsters_[x];
-		Vector3 monsterPos = monster->GetComponent<RigidBody>()->GetPosition();
-		Vector3 monsterCellPos;
-		Vector3 archerPos = archer_->GetChild("archer")->GetComponent<RigidBody>()->GetPosition();
+	Vector3 archerPos = archerHandles_.body_->GetPosition();
+
+	//Pets may take gates around the archer while their commands apply, give them back once the batch is done.
+	PODVector<int> archerGates;
+	GetArcherGates(archerGates);
+
+	HiresTimer thinkTimer;
 
-		Node* monsterCell = NULL;
-		Node* monsterCellTop = NULL;
-		Node* monsterCellBottom = NULL;
-		Node* monsterCellLeft = NULL;
-		Node* monsterCellRight = NULL;
+	if (monsterCursor_ >= count)
+	{
+		monsterCursor_ = 0;
+	}
 
-		PODVector<PhysicsRaycastResult> raeResult;
+	//Without a budget every pet is planned at once. With one, pets are planned and applied a chunk at a time from
+	//the cursor, so running out stops the planning and not just the applying.
+	unsigned chunkSize = monsterThinkBudget_ ? monsterPlanner_.GetChunkSize(main_->workQueue_) : count;
 
-		Ray rae;
-		rae.origin_ = monsterPos + Vector3(0.0f, 1.0f, 0.0f);
-		rae.direction_ = Vector3::DOWN;
+	while (monstersThought_ < count)
+	{
+		unsigned chunk = Min(chunkSize, Min(count - monstersThought_, count - monsterCursor_));
 
-		scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+		monsterPlanner_.Plan(main_->workQueue_, mazeGrid_, gateBoard_, flowField_, monsters_, archerPos,
+				monsterCursor_, chunk);
 
-		for (int y = 0; y < raeResult.Size(); y++)
+		for (unsigned x = 0; x < chunk; x++)
 		{
-			if (raeResult[y].body_->GetNode()->GetName() == "cell")
-			{
-				monsterCell = raeResult[y].body_->GetNode();
-				break;
-			}
+			MoveMonster(monsterCursor_ + x);
 		}
 
-		if (!monsterCell)//This shouldn't be necessary. Why would monsterCell ever be null?
+		monstersThought_ += chunk;
+		monsterCursor_ = (monsterCursor_ + chunk) % count;
+
+		if (monsterThinkBudget_ && thinkTimer.GetUSec(false) >= (long long)monsterThinkBudget_)
 		{
-			return;
+			break;
 		}
+	}
+
+	stats_.petsThought_ += monstersThought_;
+
+	ReopenGates(archerGates);
+}
 
-		//monsterCellPos = monsterCell->GetComponent<RigidBody>()->GetPosition();
-		monsterCellPos = monsterCell->GetPosition();
-		monsterCellPos.y_ = monsterPos.y_;
+void Gameplay::MoveMonster(unsigned slot)
+{
+	const MonsterCommand& command = monsterPlanner_.commands_[slot];
+	int monsterIndex = monsters_.cells_[slot];
+	CellSide side = (CellSide)command.side_;
 
-		Vector3 cellSize = monsterCell->GetComponent<CollisionShape>()->GetSize();
+	if (command.type_ == MONSTER_IDLE)
+	{
+		return;
+	}
+
+	//Pets applied earlier in the batch may have taken a gate this one planned to walk through.
+	if (command.type_ == MONSTER_STEP && gateBoard_.GetPassage(mazeGrid_, monsterIndex, side) != command.path_[0])
+	{
+		return;
+	}
 
-		//Top
-		rae.origin_ = monsterCellPos + Vector3(0.0f, 1.0f, cellSize.z_);
+	if (command.type_ == MONSTER_CHASE && !StealPassage(monsterIndex, side))
+	{
+		return;
+	}
 
-		raeResult.Clear();
+	monsterPath_.Clear();
 
-		scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+	int index = monsterIndex;
 
-		for (int y = 0; y < raeResult.Size(); y++)
+	for (unsigned x = 0; x < command.pathLength_; x++)
+	{
+		//Same for the later cells, walk up to the first closed one.
+		if (x > 0 && !IsPassageOpen(index, command.path_[x]))
 		{
-			if (raeResult[y].body_->GetNode()->GetName() == "cell")
-			{
-				monsterCellTop = raeResult[y].body_->GetNode();
-				break;
-			}
+			break;
 		}
 
-		//Bottom
-		rae.origin_ = monsterCellPos + Vector3(0.0f, 1.0f, -cellSize.z_);
+		index = command.path_[x];
+
+		Vector3 dest = mazeGrid_.GetCellPosition(index);
+		dest.y_ = monsters_.positions_[slot].y_;
+		monsterPath_.Push(dest);
+	}
 
-		raeResult.Clear();
+	monsters_.movers_[slot]->MoveAlong(monsterPath_, monsterSpeed_, true);
 
-		scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+	stats_.petMoves_++;
+	stats_.petCells_ += monsterPath_.Size();
+}
 
-		for (int y = 0; y < raeResult.Size(); y++)
+bool Gameplay::IsPassageOpen(int index, int neighbour) const
+{
+	for (int x = 0; x < MAX_CELL_SIDES; x++)
+	{
+		if (gateBoard_.GetPassage(mazeGrid_, index, (CellSide)x) == neighbour)
 		{
-			if (raeResult[y].body_->GetNode()->GetName() == "cell")
-			{
-				monsterCellBottom = raeResult[y].body_->GetNode();
-				break;
-			}
+			return true;
 		}
+	}
 
-		//Left
-		rae.origin_ = monsterCellPos + Vector3(-cellSize.x_, 1.0f, 0.0f);
-
-		raeResult.Clear();
+	return false;
+}
 
-		scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+void Gameplay::TrimMonsterPaths()
+{
+	//Cells were open when the path was planned, cut each path at the first passage closed since.
+	for (unsigned x = 0; x < monsters_.Size(); x++)
+	{
+		RigidBodyMoveTo* mover = monsters_.movers_[x];
 
-		for (int y = 0; y < raeResult.Size(); y++)
+		if (!mover->IsMoving() || !mover->system_)
 		{
-			if (raeResult[y].body_->GetNode()->GetName() == "cell")
-			{
-				monsterCellLeft = raeResult[y].body_->GetNode();
-				break;
-			}
+			continue;
 		}
 
-		//Right
-		rae.origin_ = monsterCellPos + Vector3(cellSize.x_, 1.0f, 0.0f);
+		//Kinematic pets don't collide with gates, one that hasn't crossed a passage closed under it turns back.
+		const Vector3& start = mover->system_->starts_[mover->slot_];
+		int source = mazeGrid_.GetCellIndex(start);
+		int index = mazeGrid_.GetCellIndex(mover->waypoints_[mover->nextWaypoint_ - 1]);
 
-		raeResult.Clear();
+		if (source != NO_CELL && index != NO_CELL && source != index && !IsPassageOpen(source, index)
+				&& mazeGrid_.GetCellIndex(monsters_.nodes_[x]->GetWorldPosition()) == source)
+		{
+			Vector3 dest = mazeGrid_.GetCellPosition(source);
+			dest.y_ = start.y_;
+			mover->MoveTo(dest, monsterSpeed_, true);
+			continue;
+		}
 
-		scene_->GetComponent<PhysicsWorld>()->Raycast(raeResult, rae, 1000.0f);
+		unsigned count = mover->GetNumWaypoints();
 
-		for (int y = 0; y < raeResult.Size(); y++)
+		for (unsigned y = 0; y < count; y++)
 		{
-			if (raeResult[y].body_->GetNode()->GetName() == "cell")
+			int next = mazeGrid_.GetCellIndex(mover->waypoints_[mover->nextWaypoint_ + y]);
+
+			if (index == NO_CELL || next == NO_CELL || !IsPassageOpen(index, next))
 			{
-				monsterCellRight = raeResult[y].body_->GetNode();
+				mover->TrimWaypoints(y);
 				break;
 			}
+
+			index = next;
 		}
+	}
+}
 
-		float xDist, zDist;
+bool Gameplay::StealPassage(int index, CellSide side)
+{
+	int neighbour = mazeGrid_.GetNeighbour(index, side);
 
-		xDist = Abs(monsterPos.x_ - archerPos.x_);
-		zDist = Abs(monsterPos.z_ - archerPos.z_);
+	if (neighbour == NO_CELL)
+	{
+		return false;
+	}
 
-		if (xDist > zDist)
-		{
-			if (monsterPos.x_ < archerPos.x_)
-			{
-				char locks = 2;
-				if (monsterCell->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedBottom")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+	//Both gates between the cells have to be open, pets take them from other cells if they aren't.
+	char locks = 2;
 
-				if (monsterCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCellRight->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCellRight->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedTop")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+	if (StealGate(index, side))
+	{
+		locks--;
+	}
 
-				if (locks == 0)
-				{
-					monster->GetComponent<RigidBodyMoveTo>()->
-							MoveTo(monsterCellPos + Vector3(cellSize.x_, 0.0f, 0.0f),
-									monsterSpeed_, true);
-				}
-			}
-			else if (monsterPos.x_ > archerPos.x_)
-			{
-				char locks = 2;
-				if (monsterCell->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedTop")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedTop")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedTop")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedTop")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+	if (StealGate(neighbour, MazeGrid::GetOppositeSide(side)))
+	{
+		locks--;
+	}
 
-				if (monsterCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedBottom")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCellLeft->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCellLeft->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedBottom")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedBottom")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedBottom")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+	return locks == 0;
+}
 
-				if (locks == 0)
-				{
-					monster->GetComponent<RigidBodyMoveTo>()->
-							MoveTo(monsterCellPos + Vector3(-cellSize.x_, 0.0f, 0.0f),
-									monsterSpeed_, true);
-				}
-			}
-		}
-		else
-		{
-			if (monsterPos.z_ < archerPos.z_)
-			{
-				char locks = 2;
-				if (monsterCell->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedRight")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+void Gameplay::UpdateFlowField(bool gatesChanged)
+{
+	TRACE("UpdateFlowField");
 
-				if (monsterCellTop->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCellTop->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCellTop->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedLeft")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+	int archerIndex = mazeGrid_.GetCellIndex(archerHandles_.body_->GetPosition());
 
-				if (locks == 0)
-				{
-					monster->GetComponent<RigidBodyMoveTo>()->
-							MoveTo(monsterCellPos + Vector3(0.0f, 0.0f, cellSize.z_),
-									monsterSpeed_, true);
-				}
-			}
-			else if (monsterPos.z_ > archerPos.z_)
-			{
-				char locks = 2;
-				if (monsterCell->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedLeft")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedLeft")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedLeft")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedLeft")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+	if (archerIndex == NO_CELL)
+	{
+		//Gate flips are not tracked while the archer is off the grid, start over once it is back.
+		flowField_.source_ = NO_CELL;
+		return;
+	}
 
-				if (monsterCellBottom->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger())
-				{
-					locks--;
-				}
-				else
-				{
-					isDestTrigger = false;
-
-					for (int y = 0; y < cells_->GetNumChildren(); y++)
-					{
-						Node* cell = cells_->GetChild(y);
-
-						if (cell->GetChild("closedRight")->GetComponent<RigidBody>()->IsTrigger())
-						{
-							isTargTrigger = true;
-
-							destXor = isDestTrigger ^ isTargTrigger;
-							targXor = isTargTrigger ^ destXor;
-
-							components.Clear();
-							if (destXor)
-							{
-								monsterCellBottom->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								monsterCellBottom->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-
-							components.Clear();
-							if (targXor)
-							{
-								cell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-								components[0]->SetEnabled(false);
-								components[1]->SetEnabled(true);
-								cell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(true);
-							}
-							else
-							{
-								if ( cell->GetChild("closedRight")->GetComponent<CollisionShape>()->
-										GetWorldBoundingBox().IsInside(archerBB) == OUTSIDE)
-								{
-									cell->GetChild("closedRight")->GetComponents<StaticModel>(components, false);
-									components[0]->SetEnabled(true);
-									components[1]->SetEnabled(false);
-									cell->GetChild("closedRight")->GetComponent<RigidBody>()->SetTrigger(false);
-								}
-							}
-
-							locks--;
-							break;
-						}
-					}
-				}
+	if (archerIndex != flowField_.source_)
+	{
+		flowField_.Build(mazeGrid_, gateBoard_, archerIndex);
 
-				if (locks == 0)
-				{
-					monster->GetComponent<RigidBodyMoveTo>()->
-							MoveTo(monsterCellPos + Vector3(0.0f, 0.0f, -cellSize.z_),
-									monsterSpeed_, true);
-				}
-			}
-		}
+		stats_.flowBuilds_++;
+		stats_.flowBuildExpanded_ += flowField_.GetLastExpanded();
+	}
+	else if (gatesChanged)
+	{
+		//Repair may still fall back to a full build when too many gates changed, it counts as a repair of that size.
+		flowField_.Repair(mazeGrid_, gateBoard_, changedGates_);
+
+		stats_.flowRepairs_++;
+		stats_.flowRepairExpanded_ += flowField_.GetLastExpanded();
+		stats_.flowRepairGates_ += changedGates_.Size();
 	}
 }
 
 void Gameplay::SpawnArrow()
 {
-	if (arrowCount_ >= arrowMax_){return;}
+	TRACE("SpawnArrow");
 
-	Node* cell = cells_->GetChild(Random(0, cells_->GetNumChildren()));
+	Node* arrow = arrowPool_.Spawn();
 
-	Node* arrow = arrow_->Clone(LOCAL);
+	if (!arrow)
+	{
+		stats_.arrowPoolEmpty_++;
+		return;
+	}
 
-	SubscribeToEvent(arrow, E_NODECOLLISIONSTART, HANDLER(Gameplay, HandleNodeCollisionStart));
+	stats_.arrowSpawns_++;
 
-	RigidBodyMoveTo* _RigidBodyMoveTo = new RigidBodyMoveTo(context_);
-	arrow->AddComponent(_RigidBodyMoveTo, 0, LOCAL);
+	Node* cell = cells_->GetChild(Random(0, cells_->GetNumChildren()));
 
 	arrow->SetPosition(cell->GetPosition() + Vector3(0.0f, 4.0f, 0.0f));
-
-	spawnedArrows_.Push(arrow);
-
-	arrowCount_++;
+	collisionMatrix_.Apply(arrow, LAYER_ARROW);
 }
 
 void Gameplay::SpawnPotion()
@@ -2054,6 +1480,7 @@ void Gameplay::SpawnPotion()
 	Node* cell = cells_->GetChild(Random(0, cells_->GetNumChildren()));
 
 	potion_->SetPosition(cell->GetPosition() + Vector3(0.0f, 4.0f, 0.0f));
+	collisionMatrix_.Apply(potion_, LAYER_PICKUP);
 }
 
 void Gameplay::SpawnChest()
@@ -2061,6 +1488,7 @@ void Gameplay::SpawnChest()
 	Node* cell = cells_->GetChild(Random(0, cells_->GetNumChildren()));
 
 	chest_->SetPosition(cell->GetPosition() + Vector3(0.0f, 4.0f, 0.0f));
+	collisionMatrix_.Apply(chest_, LAYER_PICKUP);
 }
 
 void Gameplay::SpawnElf()
@@ -2068,21 +1496,21 @@ void Gameplay::SpawnElf()
 	Node* cell = cells_->GetChild(Random(0, cells_->GetNumChildren()));
 
 	elf_->SetPosition(cell->GetPosition() + Vector3(0.0f, 4.0f, 0.0f));
+	collisionMatrix_.Apply(elf_, LAYER_PICKUP);
 
 	elf_->GetComponent<AnimationController>()->PlayExclusive("Models/elfIdle.ani", 0, true, 0.0f);
 }
 
 void Gameplay::ShootArrow()
 {
-	if (quiver_.Size())
-	{
-		Node* arrow  = quiver_[0];
-		quiver_.Remove(arrow);
+	Node* arrow = arrowPool_.PopQuiver();
 
+	if (arrow)
+	{
 		arrow->SetVar("Fired", true);
 		arrow->SetEnabledRecursive(true);
 
-		arrow->SetPosition(archer_->GetChild("archer")->GetPosition());
+		arrow->SetPosition(archerHandles_.node_->GetPosition());
 
 		if (archerDir_ == 0)
 		{
@@ -2125,8 +1553,8 @@ void Gameplay::ShootArrow()
 					MoveTo(dest, monsterSpeed_, true);
 		}
 
-		RecursiveAnimate(archer_->GetChild("archer"), "Models/archerAttack.ani", 0, false, 0.0f, true, 3.0f);
+		RecursiveAnimate(archerHandles_.node_, "Models/archerAttack.ani", 0, false, 0.0f, true, 3.0f);
 
-		shootArrow_->GetComponent<SoundSource>()->Play(shootArrow_->GetComponent<SoundSource>()->GetSound());
+		PlaySound(shootArrow_);
 	}
 }
@@ -10,7 +10,28 @@
 #include <Urho3D/Urho3D.h>
 
 #include <Urho3D/Core/Object.h>
+#include <Urho3D/Core/Timer.h>
 #include "../Urho3DPlayer.h"
+#include "Arrows/ArrowPool.h"
+#include "Collision/CollisionDispatcher.h"
+#include "Collision/CollisionLayers.h"
+#include "GameplayStats.h"
+#include "Handles/SceneHandles.h"
+#include "Hud/ScoreHud.h"
+#include "Maze/GateBoard.h"
+#include "Maze/FlowField.h"
+#include "Maze/GateSync.h"
+#include "Maze/MazeBuilder.h"
+#include "Maze/MazeColliders.h"
+#include "Maze/MazeGenerator.h"
+#include "Maze/MazeGrid.h"
+#include "Maze/MazeRenderer.h"
+#include "Monsters/MonsterBatch.h"
+#include "Monsters/MonsterPlanner.h"
+#include "Monsters/MonsterPool.h"
+#include "Persistence/ScoreStore.h"
+#include "Replay/InputLog.h"
+#include "Trace/TraceRecorder.h"
 
 using namespace Urho3D;
 
@@ -26,19 +47,51 @@ public:
 	void HandlePressed(StringHash eventType, VariantMap& eventData);
 	void HandleReleased(StringHash eventType, VariantMap& eventData);
 	void HandlePostRenderUpdate(StringHash eventType, VariantMap& eventData);
+	void HandleExitRequested(StringHash eventType, VariantMap& eventData);
+	void HandlePostUpdate(StringHash eventType, VariantMap& eventData);
 	void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
-	void HandleNodeCollisionStart(StringHash eventType, VariantMap& eventData);
+	void HandlePhysicsCollisionStart(StringHash eventType, VariantMap& eventData);
+	void HandleArcherElf(Node* archer, Node* elf);
+	void HandleArcherChest(Node* archer, Node* chest);
+	void HandleArcherPotion(Node* archer, Node* potion);
+	void HandleArcherArrow(Node* archer, Node* arrow);
+	void HandleArcherMonster(Node* archer, Node* monster);
+	void HandleArrowWall(Node* arrow, Node* wall);
+	void HandleArrowMonster(Node* arrow, Node* monster);
 	void HandleKeyDown(StringHash eventType, VariantMap& eventData);
 	void HandleKeyUp(StringHash eventType, VariantMap& eventData);
 	void HandleMouseDown(StringHash eventType, VariantMap& eventData);
+	void QueueInput(InputType type, int value, int cell);
+	void ApplyInputs();
+	void ApplyInput(const InputCommand& command);
 
+	void EndStage(GameplayStage stage, HiresTimer& stageTimer);
+	void SaveTrace();
+	void PlaySound(Node* soundNode);
+	void TagEntities();
+	void DeclareCollisionLayers();
+	void ApplyCollisionLayers();
+	void SampleContactPairs();
+	void ResolveHandles();
 	void MoveArcher();
 	void RecursiveAnimate(Node* noed, String animation, char layer, bool loop, float fadeTime, bool exclusive, float speed);
+	void LoadGates();
+	void ApplyGate(int index, CellSide side);
+	void SyncGates();
+	void GetArcherGates(PODVector<int>& gates);
+	void ReopenGates(const PODVector<int>& gates);
+	void XorGates(int destIndex, int targIndex, unsigned sides);
+	bool StealGate(int index, CellSide side);
 	void RandomizeGates();
-	void XorInnerGates();
-	void XorOuterGates();
+	void XorInnerGates(int targIndex);
+	void XorOuterGates(int targIndex);
 	void SpawnMonster();
 	void MoveMonsters();
+	void MoveMonster(unsigned slot);
+	bool StealPassage(int index, CellSide side);
+	bool IsPassageOpen(int index, int neighbour) const;
+	void TrimMonsterPaths();
+	void UpdateFlowField(bool gatesChanged);
 	void SpawnArrow();
 	void SpawnPotion();
 	void SpawnChest();
@@ -69,12 +122,30 @@ public:
 	SharedPtr<Node> gateOpen_;
 	SharedPtr<Node> shootArrow_;
 
-	Vector<Node*> closedCells_;
-	Vector<Node*> openCells_;
+	GameplayStats stats_;
+	CollisionDispatcher<Gameplay> collisionDispatcher_;
+	CollisionMatrix collisionMatrix_;
+	ArcherHandles archerHandles_;
+	ScoreHud scoreHud_;
+	ScoreStore scoreStore_;
+	InputLog inputLog_;
+	PODVector<InputCommand> pendingInputs_;
+	Vector<CellHandles> cellHandles_;
+	MazeGrid mazeGrid_;
+	GateBoard gateBoard_;
+	GateSync gateSync_;
+	PODVector<int> changedGates_;
+	MazeBuilder mazeBuilder_;
+	MazeColliders mazeColliders_;
+	MazeGenerator mazeGenerator_;
+	MazeRenderer mazeRenderer_;
+	FlowField flowField_;
 	Vector<Node*> baseMonsters_;
-	Vector<Node*> spawnedMonsters_;
-	Vector<Node*> spawnedArrows_;
-	Vector<Node*> quiver_;
+	MonsterBatch monsters_;
+	MonsterPlanner monsterPlanner_;
+	MonsterPool monsterPool_;
+	PODVector<Vector3> monsterPath_;
+	ArrowPool arrowPool_;
 
 	bool wDown_;
 	bool aDown_;
@@ -99,11 +170,16 @@ public:
 	float invincibilityInterval_;
 
 	int monsterCount_;
-	int monsterMoveTurn_;
 	int monsterMax_;
-	int arrowCount_;
 	int arrowMax_;
 	int score_;
 
+	unsigned monsterCursor_;
+	unsigned monsterThinkBudget_;
+	unsigned monstersThought_;
+	unsigned physicsTick_;
+	unsigned mazeSeed_;
+	unsigned mazeGeneration_;
+
 	char archerDir_;
 };
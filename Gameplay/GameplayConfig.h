@@ -0,0 +1,48 @@
+/*
+ * GameplayConfig.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+//Settings a run of Gameplay starts from. The game uses the defaults, the benchmark sweeps them.
+struct GameplayConfig
+{
+	GameplayConfig() :
+		mazeWidth_(0),
+		mazeHeight_(0),
+		monsterMax_(6),
+		arrowMax_(5),
+		randomizeGatesInterval_(10.0f),
+		kinematicPets_(true),
+		monsterPathLength_(4),
+		monsterThinkBudget_(0),
+		collisionLayers_(true),
+		saveTopScore_(true),
+		timeStages_(false)
+	{
+	}
+
+	//Cells across and down, 0 keeps the maze authored in the scene.
+	int mazeWidth_;
+	int mazeHeight_;
+	int monsterMax_;
+	int arrowMax_;
+	//Seconds between gate randomisations.
+	float randomizeGatesInterval_;
+	//Pets glide from cell to cell on kinematic bodies instead of being pushed by velocity.
+	bool kinematicPets_;
+	//Cells of the flow field a pet walks before the AI plans it again.
+	unsigned monsterPathLength_;
+	//Microseconds the AI stage may spend per tick before resuming at the next pet on the next tick, 0 for no limit.
+	unsigned monsterThinkBudget_;
+	//Apply the collision matrix, off leaves every body on the authored layers.
+	bool collisionLayers_;
+	bool saveTopScore_;
+	//Accumulate per-stage timings into Gameplay::stats_.
+	bool timeStages_;
+};
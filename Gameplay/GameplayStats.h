@@ -0,0 +1,89 @@
+/*
+ * GameplayStats.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+//The stages of a physics tick, in the order HandlePhysicsPreStep runs them, then the collision handler.
+enum GameplayStage
+{
+	STAGE_INPUT = 0,
+	STAGE_ARCHER,
+	STAGE_GATES,
+	STAGE_MONSTER_SPAWN,
+	STAGE_AI,
+	STAGE_ARROW_SPAWN,
+	STAGE_SYNC,
+	STAGE_COLLISION,
+	MAX_GAMEPLAY_STAGES
+};
+
+//Time spent in each stage and how often it ran, filled when GameplayConfig::timeStages_ is set.
+struct GameplayStats
+{
+	GameplayStats()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		for (int x = 0; x < MAX_GAMEPLAY_STAGES; x++)
+		{
+			usec_[x] = 0;
+			calls_[x] = 0;
+		}
+
+		broadphasePairs_ = 0;
+		contactManifolds_ = 0;
+		pairSamples_ = 0;
+		flowBuilds_ = 0;
+		flowBuildExpanded_ = 0;
+		flowRepairs_ = 0;
+		flowRepairExpanded_ = 0;
+		flowRepairGates_ = 0;
+		gateSyncs_ = 0;
+		gatesTouched_ = 0;
+		monsterPoolHits_ = 0;
+		monsterPoolFallbacks_ = 0;
+		monsterPoolMisses_ = 0;
+		arrowSpawns_ = 0;
+		arrowPoolEmpty_ = 0;
+		petsThought_ = 0;
+		petMoves_ = 0;
+		petCells_ = 0;
+	}
+
+	long long usec_[MAX_GAMEPLAY_STAGES];
+	unsigned calls_[MAX_GAMEPLAY_STAGES];
+	//Summed once per tick, divide by pairSamples_ for the average.
+	unsigned long long broadphasePairs_;
+	unsigned long long contactManifolds_;
+	unsigned pairSamples_;
+	//Flow field rebuilds and repairs with the cells each settled, and the changed gates the repairs were given.
+	unsigned flowBuilds_;
+	unsigned long long flowBuildExpanded_;
+	unsigned flowRepairs_;
+	unsigned long long flowRepairExpanded_;
+	unsigned long long flowRepairGates_;
+	//SyncGates calls and the gates they applied to the scene, only gates whose state really changed count.
+	unsigned gateSyncs_;
+	unsigned long long gatesTouched_;
+	//How spawned pets were served: a pooled pet of the asked type, one of another type, or a fresh clone.
+	unsigned monsterPoolHits_;
+	unsigned monsterPoolFallbacks_;
+	unsigned monsterPoolMisses_;
+	//Arrows placed in the maze, and spawns skipped because every pooled arrow was already out.
+	unsigned arrowSpawns_;
+	unsigned arrowPoolEmpty_;
+	//Pets the AI stage got through, short of every pet each tick when the think budget runs out.
+	unsigned petsThought_;
+	//Paths handed to pets and the cells they covered.
+	unsigned petMoves_;
+	unsigned petCells_;
+};
@@ -0,0 +1,73 @@
+/*
+ * SceneHandles.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/IO/Log.h>
+
+#include "SceneHandles.h"
+
+bool ArcherHandles::Resolve(Node* archer)
+{
+	node_ = archer ? archer->GetChild("archer") : 0;
+
+	if (!node_)
+	{
+		LOGERROR("Archer handles: archer node not found");
+		return false;
+	}
+
+	sparkle_ = node_->GetChild("invincibilitysparkle");
+	body_ = node_->GetComponent<RigidBody>();
+	shape_ = node_->GetComponent<CollisionShape>();
+	animation_ = node_->GetComponent<AnimationController>();
+
+	return IsValid();
+}
+
+bool GateHandles::Resolve(Node* gate)
+{
+	node_ = gate;
+
+	if (!gate)
+	{
+		return false;
+	}
+
+	PODVector<StaticModel*> models;
+	gate->GetComponents<StaticModel>(models, false);
+
+	//The first model shows the closed gate, the second the open one.
+	body_ = gate->GetComponent<RigidBody>();
+	closedModel_ = models.Size() > 0 ? models[0] : 0;
+	openModel_ = models.Size() > 1 ? models[1] : 0;
+
+	return IsValid();
+}
+
+bool CellHandles::Resolve(Node* cell)
+{
+	node_ = cell;
+
+	if (!cell)
+	{
+		return false;
+	}
+
+	bool valid = true;
+
+	for (int x = 0; x < MAX_CELL_SIDES; x++)
+	{
+		if (!gates_[x].Resolve(cell->GetChild(MazeGrid::GetGateName((CellSide)x))))
+		{
+			LOGERRORF("Cell handles: %s has an incomplete %s gate", cell->GetName().CString(),
+					MazeGrid::GetGateName((CellSide)x));
+			valid = false;
+		}
+	}
+
+	return valid;
+}
@@ -0,0 +1,54 @@
+/*
+ * SceneHandles.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Graphics/AnimationController.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "../Maze/MazeGrid.h"
+
+using namespace Urho3D;
+
+//Child nodes and components looked up once at load instead of by name every tick. Everything is held weakly,
+//so a handle whose node has been removed reads as null rather than dangling.
+struct ArcherHandles
+{
+	bool Resolve(Node* archer);
+	bool IsValid() const { return node_ && body_; }
+
+	WeakPtr<Node> node_;
+	WeakPtr<Node> sparkle_;
+	WeakPtr<RigidBody> body_;
+	WeakPtr<CollisionShape> shape_;
+	WeakPtr<AnimationController> animation_;
+};
+
+struct GateHandles
+{
+	bool Resolve(Node* gate);
+	bool IsValid() const { return node_ && body_ && closedModel_ && openModel_; }
+
+	WeakPtr<Node> node_;
+	WeakPtr<RigidBody> body_;
+	WeakPtr<StaticModel> closedModel_;
+	WeakPtr<StaticModel> openModel_;
+};
+
+struct CellHandles
+{
+	bool Resolve(Node* cell);
+	bool IsValid() const { return node_; }
+
+	WeakPtr<Node> node_;
+	GateHandles gates_[MAX_CELL_SIDES];
+};
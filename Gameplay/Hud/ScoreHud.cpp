@@ -0,0 +1,70 @@
+/*
+ * ScoreHud.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/UI/Text3D.h>
+
+#include <stdio.h>
+
+#include "ScoreHud.h"
+
+ScoreHud::ScoreHud() :
+	rebuilds_(0),
+	score_(0),
+	shownScore_(0),
+	topScore_(0),
+	shownTopScore_(0)
+{
+}
+
+void ScoreHud::Init(Node* scoreText, Node* topScoreText, int score, int topScore)
+{
+	scoreText_ = scoreText;
+	topScoreText_ = topScoreText;
+
+	score_ = shownScore_ = score;
+	topScore_ = shownTopScore_ = topScore;
+
+	Rebuild(scoreText_, "The Score ", score_);
+	Rebuild(topScoreText_, "Top Score ", topScore_);
+}
+
+void ScoreHud::Flush()
+{
+	if (score_ != shownScore_)
+	{
+		shownScore_ = score_;
+		Rebuild(scoreText_, "The Score ", score_);
+	}
+
+	if (topScore_ != shownTopScore_)
+	{
+		shownTopScore_ = topScore_;
+		Rebuild(topScoreText_, "Top Score ", topScore_);
+	}
+}
+
+void ScoreHud::Rebuild(Node* textNode, const char* prefix, int value)
+{
+	if (!textNode)
+	{
+		return;
+	}
+
+	//Format into the kept string so no temporaries are built per change.
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%s%d", prefix, value);
+	text_ = buffer;
+
+	Text3D* text = textNode->GetComponent<Text3D>();
+	text->SetText(text_);
+	text->SetWidth(12);
+	textNode->ApplyAttributes();
+
+	rebuilds_++;
+}
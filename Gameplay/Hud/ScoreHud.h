@@ -0,0 +1,47 @@
+/*
+ * ScoreHud.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/Str.h>
+
+namespace Urho3D
+{
+class Node;
+class Text3D;
+}
+
+using namespace Urho3D;
+
+//Score and top score texts. Setting a value only records it, Flush() rebuilds each text at most once per
+//frame and only when the value differs from the one on screen.
+class ScoreHud
+{
+public:
+	ScoreHud();
+
+	void Init(Node* scoreText, Node* topScoreText, int score, int topScore);
+	void SetScore(int score) { score_ = score; }
+	void SetTopScore(int topScore) { topScore_ = topScore; }
+	void Flush();
+
+	unsigned rebuilds_;
+
+private:
+	void Rebuild(Node* textNode, const char* prefix, int value);
+
+	WeakPtr<Node> scoreText_;
+	WeakPtr<Node> topScoreText_;
+	String text_;
+
+	int score_;
+	int shownScore_;
+	int topScore_;
+	int shownTopScore_;
+};
@@ -0,0 +1,163 @@
+/*
+ * MoverSystem.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Graphics/AnimationController.h>
+#include <Urho3D/Physics/PhysicsEvents.h>
+#include <Urho3D/Physics/PhysicsWorld.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "MoverSystem.h"
+#include "RigidBodyMoveTo.h"
+
+MoverSystem::MoverSystem(Context* context) :
+	Component(context)
+{
+}
+
+void MoverSystem::OnNodeSet(Node* node)
+{
+	if (!node)
+	{
+		return;
+	}
+
+	//Same event the LogicComponent fixed updates ran from.
+	PhysicsWorld* world = node->GetComponent<PhysicsWorld>();
+
+	if (world)
+	{
+		SubscribeToEvent(world, E_PHYSICSPRESTEP, HANDLER(MoverSystem, HandlePhysicsPreStep));
+	}
+	else
+	{
+		SubscribeToEvent(E_PHYSICSPRESTEP, HANDLER(MoverSystem, HandlePhysicsPreStep));
+	}
+}
+
+unsigned MoverSystem::Add(RigidBodyMoveTo* mover)
+{
+	movers_.Push(mover);
+	nodes_.Push(mover->GetNode());
+	bodies_.Push(mover->body_);
+	animations_.Push(mover->animation_);
+	starts_.Push(Vector3::ZERO);
+	dests_.Push(Vector3::ZERO);
+	speeds_.Push(0.0f);
+	travelTimes_.Push(0.0f);
+	elapsedTimes_.Push(0.0f);
+	stopOnCompletion_.Push(0);
+	kinematic_.Push(0);
+
+	return movers_.Size() - 1;
+}
+
+void MoverSystem::Remove(unsigned slot)
+{
+	unsigned last = movers_.Size() - 1;
+
+	movers_[slot]->slot_ = M_MAX_UNSIGNED;
+
+	if (slot != last)
+	{
+		movers_[slot] = movers_[last];
+		nodes_[slot] = nodes_[last];
+		bodies_[slot] = bodies_[last];
+		animations_[slot] = animations_[last];
+		starts_[slot] = starts_[last];
+		dests_[slot] = dests_[last];
+		speeds_[slot] = speeds_[last];
+		travelTimes_[slot] = travelTimes_[last];
+		elapsedTimes_[slot] = elapsedTimes_[last];
+		stopOnCompletion_[slot] = stopOnCompletion_[last];
+		kinematic_[slot] = kinematic_[last];
+		movers_[slot]->slot_ = slot;
+	}
+
+	movers_.Resize(last);
+	nodes_.Resize(last);
+	bodies_.Resize(last);
+	animations_.Resize(last);
+	starts_.Resize(last);
+	dests_.Resize(last);
+	speeds_.Resize(last);
+	travelTimes_.Resize(last);
+	elapsedTimes_.Resize(last);
+	stopOnCompletion_.Resize(last);
+	kinematic_.Resize(last);
+}
+
+void MoverSystem::HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData)
+{
+	using namespace PhysicsPreStep;
+
+	float timeStep = eventData[P_TIMESTEP].GetFloat();
+
+	unsigned x = 0;
+
+	while (x < movers_.Size())
+	{
+		//Like the LogicComponent it replaced, a move only advances while its component and node are enabled.
+		if (!movers_[x]->IsEnabledEffective())
+		{
+			x++;
+			continue;
+		}
+
+		elapsedTimes_[x] += timeStep;
+
+		if (kinematic_[x])
+		{
+			float t = travelTimes_[x] > 0.0f ? Min(elapsedTimes_[x] / travelTimes_[x], 1.0f) : 1.0f;
+			nodes_[x]->SetWorldPosition(starts_[x].Lerp(dests_[x], t));
+		}
+
+		if (elapsedTimes_[x] < travelTimes_[x])
+		{
+			x++;
+			continue;
+		}
+
+		//Pushed off course, head for the destination again from where it is now.
+		Vector3 loc = nodes_[x]->GetWorldPosition();
+
+		if (!kinematic_[x] && loc != dests_[x] && (loc - dests_[x]).Length() > 0.5f)
+		{
+			movers_[x]->StartLeg(dests_[x]);
+			x++;
+			continue;
+		}
+
+		RigidBodyMoveTo* mover = movers_[x];
+
+		//More waypoints queued, carry straight on into the next leg.
+		if (mover->NextWaypoint())
+		{
+			x++;
+			continue;
+		}
+
+		if (stopOnCompletion_[x] && !kinematic_[x])
+		{
+			bodies_[x]->SetLinearVelocity(Vector3::ZERO);
+		}
+
+		if (stopOnCompletion_[x])
+		{
+			if (animations_[x])//quick hack to deal with animating the pets
+			{
+				animations_[x]->StopAll(0.0f);
+			}
+		}
+
+		//The last move takes this slot, it is checked next without advancing.
+		Remove(x);
+		mover->OnMoveToComplete();
+	}
+}
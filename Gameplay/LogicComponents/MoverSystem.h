@@ -0,0 +1,57 @@
+/*
+ * MoverSystem.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Math/Vector3.h>
+#include <Urho3D/Scene/Component.h>
+
+namespace Urho3D
+{
+class AnimationController;
+class Node;
+class RigidBody;
+}
+
+using namespace Urho3D;
+
+class RigidBodyMoveTo;
+
+//Scene component that owns every active RigidBodyMoveTo move in parallel arrays and advances them all in one
+//loop per physics step, instead of one FixedUpdate event per component. Finished moves are swap-removed, so the
+//arrays only ever hold moves in progress. Dynamic moves steer the body by velocity; kinematic moves place the node
+//on the line from start to destination by elapsed time, so they arrive exactly and Bullet has nothing to integrate.
+class MoverSystem : public Component
+{
+	OBJECT(MoverSystem);
+public:
+	MoverSystem(Context* context);
+
+	unsigned Add(RigidBodyMoveTo* mover);
+	void Remove(unsigned slot);
+
+	unsigned GetNumActive() const { return movers_.Size(); }
+
+	void HandlePhysicsPreStep(StringHash eventType, VariantMap& eventData);
+
+	PODVector<RigidBodyMoveTo*> movers_;
+	PODVector<Node*> nodes_;
+	PODVector<RigidBody*> bodies_;
+	PODVector<AnimationController*> animations_;
+	PODVector<Vector3> starts_;
+	PODVector<Vector3> dests_;
+	PODVector<float> speeds_;
+	PODVector<float> travelTimes_;
+	PODVector<float> elapsedTimes_;
+	PODVector<unsigned char> stopOnCompletion_;
+	PODVector<unsigned char> kinematic_;
+
+protected:
+	virtual void OnNodeSet(Node* node);
+};
@@ -8,28 +8,49 @@
 #include <Urho3D/Urho3D.h>
 #include <Urho3D/Graphics/AnimationController.h>
 #include <Urho3D/Graphics/AnimatedModel.h>
-#include <Urho3D/Math/BoundingBox.h>
-#include <Urho3D/Physics/CollisionShape.h>
-#include <Urho3D/IO/Log.h>
-#include <Urho3D/Scene/LogicComponent.h>
-#include <Urho3D/IO/MemoryBuffer.h>
+#include <Urho3D/Math/MathDefs.h>
 #include <Urho3D/Scene/Node.h>
-#include <Urho3D/Graphics/Octree.h>
-#include <Urho3D/Physics/PhysicsEvents.h>
-#include <Urho3D/Physics/PhysicsWorld.h>
 #include <Urho3D/Physics/RigidBody.h>
 #include <Urho3D/Scene/Scene.h>
-#include <Urho3D/Scene/SceneEvents.h>
-#include <Urho3D/Core/Variant.h>
 
+#include "MoverSystem.h"
 #include "RigidBodyMoveTo.h"
 
 RigidBodyMoveTo::RigidBodyMoveTo(Context* context) :
-		LogicComponent(context)
+		Component(context)
 {
-	isMoving_ = false;
-	// Only the physics update event is needed: unsubscribe from the rest for optimization
-	SetUpdateEventMask(USE_FIXEDUPDATE);
+	nextWaypoint_ = 0;
+	slot_ = M_MAX_UNSIGNED;
+	body_ = 0;
+	animation_ = 0;
+	kinematic_ = false;
+}
+
+RigidBodyMoveTo::~RigidBodyMoveTo()
+{
+	if (IsMoving() && system_)
+	{
+		system_->Remove(slot_);
+	}
+}
+
+void RigidBodyMoveTo::OnNodeSet(Node* node)
+{
+	if (!node)
+	{
+		return;
+	}
+
+	//Bodies and controllers are added with the node and stay for its lifetime, look them up once.
+	body_ = node->GetComponent<RigidBody>();
+	animation_ = node->GetComponent<AnimationController>();
+
+	Scene* scene = node->GetScene();
+
+	if (scene)
+	{
+		system_ = scene->GetOrCreateComponent<MoverSystem>(LOCAL);
+	}
 }
 
 void RigidBodyMoveTo::OnMoveToComplete()
@@ -39,52 +60,127 @@ void RigidBodyMoveTo::OnMoveToComplete()
 
 void RigidBodyMoveTo::MoveTo(Vector3 dest, float speed, bool stopOnCompletion)
 {
-	moveToSpeed_ = speed;
-	moveToDest_ = dest;
-	moveToLoc_ = node_->GetWorldPosition();
-	moveToDir_ = dest - moveToLoc_;
-	moveToDir_.Normalize();
-	moveToTravelTime_ = (moveToDest_ - moveToLoc_).Length() / speed;
-	moveToElapsedTime_ = 0.0f;
-	moveToStopOnTime_ = stopOnCompletion;
-	isMoving_ = true;
-	node_->GetComponent<RigidBody>()->SetLinearVelocity(moveToDir_ * speed);
-
-	if (node_->GetComponent<AnimationController>())//quick hack to deal with animating the pets
+	waypoints_.Clear();
+	waypoints_.Push(dest);
+
+	Begin(speed, stopOnCompletion);
+}
+
+void RigidBodyMoveTo::MoveAlong(const PODVector<Vector3>& waypoints, float speed, bool stopOnCompletion)
+{
+	if (waypoints.Empty())
+	{
+		return;
+	}
+
+	waypoints_ = waypoints;
+
+	Begin(speed, stopOnCompletion);
+}
+
+void RigidBodyMoveTo::Begin(float speed, bool stopOnCompletion)
+{
+	nextWaypoint_ = 0;
+
+	if (!system_ || !body_)
+	{
+		waypoints_.Clear();
+		return;
+	}
+
+	if (!IsMoving())
+	{
+		slot_ = system_->Add(this);
+	}
+
+	system_->speeds_[slot_] = speed;
+	system_->stopOnCompletion_[slot_] = stopOnCompletion;
+	system_->kinematic_[slot_] = kinematic_;
+
+	NextWaypoint();
+
+	//Legs after the first keep the animation running.
+	if (animation_)//quick hack to deal with animating the pets
+	{
+		animation_->PlayExclusive("Models/petRun.ani", 0, true, 0.0f);
+		animation_->SetStartBone("Models/petRun.ani", "PantherPelvis");
+	}
+}
+
+bool RigidBodyMoveTo::NextWaypoint()
+{
+	if (nextWaypoint_ >= waypoints_.Size())
+	{
+		return false;
+	}
+
+	StartLeg(waypoints_[nextWaypoint_++]);
+
+	return true;
+}
+
+void RigidBodyMoveTo::StartLeg(const Vector3& dest)
+{
+	Vector3 loc = node_->GetWorldPosition();
+	Vector3 dir = dest - loc;
+	dir.Normalize();
+
+	float speed = system_->speeds_[slot_];
+
+	system_->starts_[slot_] = loc;
+	system_->dests_[slot_] = dest;
+	system_->travelTimes_[slot_] = (dest - loc).Length() / speed;
+	system_->elapsedTimes_[slot_] = 0.0f;
+
+	if (!kinematic_)
 	{
-		node_->GetComponent<AnimationController>()->PlayExclusive("Models/petRun.ani", 0, true, 0.0f);
-		node_->GetComponent<AnimationController>()->SetStartBone("Models/petRun.ani", "PantherPelvis");
+		body_->SetLinearVelocity(dir * speed);
+	}
 
+	if (animation_)
+	{
 		Vector3 lookAtPos = dest;
-		lookAtPos.y_ = moveToLoc_.y_;
+		lookAtPos.y_ = loc.y_;
 		node_->LookAt(lookAtPos);
 	}
 }
 
-void RigidBodyMoveTo::FixedUpdate(float timeStep)
+void RigidBodyMoveTo::TrimWaypoints(unsigned count)
 {
-	if (isMoving_ == true)
+	if (count < GetNumWaypoints())
+	{
+		waypoints_.Resize(nextWaypoint_ + count);
+	}
+}
+
+void RigidBodyMoveTo::SetKinematic(bool enable)
+{
+	kinematic_ = enable;
+
+	if (body_)
+	{
+		body_->SetKinematic(enable);
+	}
+}
+
+void RigidBodyMoveTo::Stop()
+{
+	if (IsMoving() && system_)
+	{
+		system_->Remove(slot_);
+	}
+
+	slot_ = M_MAX_UNSIGNED;
+	waypoints_.Clear();
+	nextWaypoint_ = 0;
+
+	if (body_)
+	{
+		body_->SetLinearVelocity(Vector3::ZERO);
+	}
+
+	if (animation_)
 	{
-		moveToElapsedTime_ += timeStep;
-		if (moveToElapsedTime_ >= moveToTravelTime_)
-		{
-			moveToLoc_ = node_->GetWorldPosition();
-			if (moveToLoc_ != moveToDest_ && (moveToLoc_ - moveToDest_).Length() > 0.5f)
-			{
-				MoveTo(moveToDest_, moveToSpeed_, moveToStopOnTime_);
-				return;
-			}
-			isMoving_ = false;
-			if (moveToStopOnTime_ == true)
-			{
-				node_->GetComponent<RigidBody>()->SetLinearVelocity(Vector3::ZERO);
-
-				if (node_->GetComponent<AnimationController>())//quick hack to deal with animating the pets
-				{
-					node_->GetComponent<AnimationController>()->StopAll(0.0f);
-				}
-			}
-			OnMoveToComplete();
-		}
+		animation_->StopAll(0.0f);
 	}
 }
@@ -8,32 +8,60 @@
 #pragma once
 
 #include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/Vector.h>
 #include <Urho3D/Core/Object.h>
-#include <Urho3D/Scene/LogicComponent.h>
+#include <Urho3D/Math/MathDefs.h>
+#include <Urho3D/Scene/Component.h>
+
+namespace Urho3D
+{
+class AnimationController;
+class RigidBody;
+}
 
 // All Urho3D classes reside in namespace Urho3D
 using namespace Urho3D;
 
+class MoverSystem;
+
 static const StringHash E_RIGIDBODYMOVETOCOMPLETE("RigidBodyMoveToComplete");
 
-class RigidBodyMoveTo: public LogicComponent
+//Moves its node's body in a straight line. The move itself is advanced by the scene's MoverSystem, this
+//component only starts and stops it. In kinematic mode the body is made kinematic and the node is placed along
+//the line instead of being pushed by velocity. A queue of waypoints is followed leg after leg without stopping,
+//completion is only sent once the last one is reached.
+class RigidBodyMoveTo: public Component
 {
 	OBJECT(RigidBodyMoveTo);
 public:
 	RigidBodyMoveTo(Context* context);
-	virtual void FixedUpdate(float timeStep);
+	~RigidBodyMoveTo();
 	void OnMoveToComplete();
 	void MoveTo(Vector3 dest, float speed, bool stopOnCompletion);
+	void MoveAlong(const PODVector<Vector3>& waypoints, float speed, bool stopOnCompletion);
+	//Heads for the next queued waypoint, false when the last one has been reached.
+	bool NextWaypoint();
+	void StartLeg(const Vector3& dest);
+	//Drops queued waypoints past the first count, the leg under way is finished either way.
+	void TrimWaypoints(unsigned count);
+	void Stop();
+	void SetKinematic(bool enable);
+
+	bool IsMoving() const { return slot_ != M_MAX_UNSIGNED; }
+	unsigned GetNumWaypoints() const { return waypoints_.Size() - nextWaypoint_; }
+
+	PODVector<Vector3> waypoints_;
+	unsigned nextWaypoint_;
+	unsigned slot_;
+	WeakPtr<MoverSystem> system_;
+	RigidBody* body_;
+	AnimationController* animation_;
+	bool kinematic_;
 
-	bool moveToStopOnTime_;
-	bool isMoving_;
-	float moveToSpeed_;
-	float moveToTravelTime_;
-	float moveToElapsedTime_;
-	float inderp_;
-	float remainingDist_;
-	Vector3 moveToDest_;
-	Vector3 moveToLoc_;
-	Vector3 moveToDir_;
+protected:
+	virtual void OnNodeSet(Node* node);
 
+private:
+	void Begin(float speed, bool stopOnCompletion);
 };
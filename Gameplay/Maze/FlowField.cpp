@@ -0,0 +1,284 @@
+/*
+ * FlowField.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Sort.h>
+
+#include "FlowField.h"
+
+static bool CompareFlowEntries(const FlowEntry& lhs, const FlowEntry& rhs)
+{
+	return lhs.distance_ < rhs.distance_;
+}
+
+FlowField::FlowField() :
+	source_(NO_CELL),
+	lastExpanded_(0),
+	totalExpanded_(0),
+	seedPos_(0),
+	fifoPos_(0)
+{
+}
+
+void FlowField::Build(const MazeGrid& grid, const GateBoard& board, int sourceIndex)
+{
+	int numCells = grid.GetNumCells();
+
+	source_ = sourceIndex;
+	lastExpanded_ = 0;
+
+	distances_.Resize(numCells);
+	queue_.Resize(numCells);
+
+	for (int x = 0; x < numCells; x++)
+	{
+		distances_[x] = FLOW_UNREACHABLE;
+	}
+
+	if (!grid.IsValid(sourceIndex))
+	{
+		return;
+	}
+
+	int head = 0;
+	int tail = 0;
+
+	distances_[sourceIndex] = 0;
+	queue_[tail++] = sourceIndex;
+
+	while (head < tail)
+	{
+		int index = queue_[head++];
+		unsigned distance = distances_[index] + 1;
+
+		for (int x = 0; x < MAX_CELL_SIDES; x++)
+		{
+			int neighbour = board.GetPassage(grid, index, (CellSide)x);
+
+			if (neighbour != NO_CELL && distances_[neighbour] == FLOW_UNREACHABLE)
+			{
+				distances_[neighbour] = distance;
+				queue_[tail++] = neighbour;
+			}
+		}
+	}
+
+	lastExpanded_ = tail;
+	totalExpanded_ += lastExpanded_;
+}
+
+void FlowField::Repair(const MazeGrid& grid, const GateBoard& board, const PODVector<int>& changedGates)
+{
+	//Past a point it is cheaper to start over than to repair.
+	if (source_ == NO_CELL || (int)changedGates.Size() * 4 > grid.GetNumCells())
+	{
+		Build(grid, board, source_);
+		return;
+	}
+
+	lastExpanded_ = 0;
+
+	//Cells whose parent passage closed may have lost their shortest path. Walk outward from them in distance
+	//order and clear every cell left without an open neighbour one step closer to the source.
+	seeds_.Clear();
+	fifo_.Clear();
+	invalidated_.Clear();
+
+	for (unsigned x = 0; x < changedGates.Size(); x++)
+	{
+		int index = changedGates[x] / MAX_CELL_SIDES;
+		CellSide side = (CellSide)(changedGates[x] % MAX_CELL_SIDES);
+		int neighbour = grid.GetNeighbour(index, side);
+
+		if (neighbour == NO_CELL || board.GetPassage(grid, index, side) != NO_CELL)
+		{
+			continue;
+		}
+
+		unsigned distance = distances_[index];
+		unsigned neighbourDistance = distances_[neighbour];
+
+		if (distance != FLOW_UNREACHABLE && distance + 1 == neighbourDistance)
+		{
+			seeds_.Push(FlowEntry(neighbour, neighbourDistance));
+		}
+		else if (neighbourDistance != FLOW_UNREACHABLE && neighbourDistance + 1 == distance)
+		{
+			seeds_.Push(FlowEntry(index, distance));
+		}
+	}
+
+	Sort(seeds_.Begin(), seeds_.End(), CompareFlowEntries);
+	seedPos_ = 0;
+	fifoPos_ = 0;
+
+	FlowEntry entry;
+
+	while (PopEntry(entry))
+	{
+		unsigned distance = distances_[entry.index_];
+
+		if (distance == FLOW_UNREACHABLE || HasSupport(grid, board, entry.index_))
+		{
+			continue;
+		}
+
+		distances_[entry.index_] = FLOW_UNREACHABLE;
+		invalidated_.Push(entry.index_);
+		lastExpanded_++;
+
+		for (int x = 0; x < MAX_CELL_SIDES; x++)
+		{
+			int neighbour = board.GetPassage(grid, entry.index_, (CellSide)x);
+
+			if (neighbour != NO_CELL && distances_[neighbour] == distance + 1)
+			{
+				fifo_.Push(FlowEntry(neighbour, distance + 1));
+			}
+		}
+	}
+
+	//Refill the cleared cells from the cells around them and let opened passages lower distances. Seeds are
+	//sorted and every propagated entry is one more than the entry that pushed it, so merging the two queues
+	//settles cells in distance order like a breadth-first search would.
+	seeds_.Clear();
+	fifo_.Clear();
+
+	for (unsigned x = 0; x < invalidated_.Size(); x++)
+	{
+		unsigned best = FLOW_UNREACHABLE;
+
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
+		{
+			int neighbour = board.GetPassage(grid, invalidated_[x], (CellSide)y);
+
+			if (neighbour != NO_CELL && distances_[neighbour] != FLOW_UNREACHABLE && distances_[neighbour] + 1 < best)
+			{
+				best = distances_[neighbour] + 1;
+			}
+		}
+
+		if (best != FLOW_UNREACHABLE)
+		{
+			seeds_.Push(FlowEntry(invalidated_[x], best));
+		}
+	}
+
+	for (unsigned x = 0; x < changedGates.Size(); x++)
+	{
+		int index = changedGates[x] / MAX_CELL_SIDES;
+		int neighbour = board.GetPassage(grid, index, (CellSide)(changedGates[x] % MAX_CELL_SIDES));
+
+		if (neighbour == NO_CELL)
+		{
+			continue;
+		}
+
+		unsigned distance = distances_[index];
+		unsigned neighbourDistance = distances_[neighbour];
+
+		if (distance != FLOW_UNREACHABLE && distance + 1 < neighbourDistance)
+		{
+			seeds_.Push(FlowEntry(neighbour, distance + 1));
+		}
+		else if (neighbourDistance != FLOW_UNREACHABLE && neighbourDistance + 1 < distance)
+		{
+			seeds_.Push(FlowEntry(index, neighbourDistance + 1));
+		}
+	}
+
+	Sort(seeds_.Begin(), seeds_.End(), CompareFlowEntries);
+	seedPos_ = 0;
+	fifoPos_ = 0;
+
+	while (PopEntry(entry))
+	{
+		if (entry.distance_ >= distances_[entry.index_])
+		{
+			continue;
+		}
+
+		distances_[entry.index_] = entry.distance_;
+		lastExpanded_++;
+
+		for (int x = 0; x < MAX_CELL_SIDES; x++)
+		{
+			int neighbour = board.GetPassage(grid, entry.index_, (CellSide)x);
+
+			if (neighbour != NO_CELL && entry.distance_ + 1 < distances_[neighbour])
+			{
+				fifo_.Push(FlowEntry(neighbour, entry.distance_ + 1));
+			}
+		}
+	}
+
+	totalExpanded_ += lastExpanded_;
+}
+
+int FlowField::GetNextStep(const MazeGrid& grid, const GateBoard& board, int index) const
+{
+	unsigned distance = GetDistance(index);
+
+	if (distance == FLOW_UNREACHABLE || distance == 0)
+	{
+		return NO_CELL;
+	}
+
+	for (int x = 0; x < MAX_CELL_SIDES; x++)
+	{
+		int neighbour = board.GetPassage(grid, index, (CellSide)x);
+
+		if (neighbour != NO_CELL && distances_[neighbour] == distance - 1)
+		{
+			return neighbour;
+		}
+	}
+
+	return NO_CELL;
+}
+
+bool FlowField::HasSupport(const MazeGrid& grid, const GateBoard& board, int index) const
+{
+	unsigned distance = distances_[index];
+
+	if (distance == 0)
+	{
+		return true;
+	}
+
+	for (int x = 0; x < MAX_CELL_SIDES; x++)
+	{
+		int neighbour = board.GetPassage(grid, index, (CellSide)x);
+
+		if (neighbour != NO_CELL && distances_[neighbour] == distance - 1)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FlowField::PopEntry(FlowEntry& entry)
+{
+	bool hasSeed = seedPos_ < seeds_.Size();
+	bool hasFifo = fifoPos_ < fifo_.Size();
+
+	if (hasSeed && (!hasFifo || seeds_[seedPos_].distance_ <= fifo_[fifoPos_].distance_))
+	{
+		entry = seeds_[seedPos_++];
+		return true;
+	}
+
+	if (hasFifo)
+	{
+		entry = fifo_[fifoPos_++];
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,75 @@
+/*
+ * FlowField.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+
+#include "GateBoard.h"
+#include "MazeGrid.h"
+
+using namespace Urho3D;
+
+static const unsigned FLOW_UNREACHABLE = 0xFFFFFFFF;
+
+struct FlowEntry
+{
+	FlowEntry() :
+		index_(NO_CELL),
+		distance_(FLOW_UNREACHABLE)
+	{
+	}
+
+	FlowEntry(int index, unsigned distance) :
+		index_(index),
+		distance_(distance)
+	{
+	}
+
+	int index_;
+	unsigned distance_;
+};
+
+//Breadth-first distances from the source cell over open passages, shared by every pet chasing it.
+//Gate flips are repaired in place: cells that lost their shortest path are cleared and refilled from
+//the cells around them, and opened passages only spread shorter distances, so the work done follows
+//the size of the change. GetLastExpanded() counts the cells settled by the last Build or Repair.
+class FlowField
+{
+public:
+	FlowField();
+
+	void Build(const MazeGrid& grid, const GateBoard& board, int sourceIndex);
+	void Repair(const MazeGrid& grid, const GateBoard& board, const PODVector<int>& changedGates);
+	int GetNextStep(const MazeGrid& grid, const GateBoard& board, int index) const;
+
+	unsigned GetDistance(int index) const
+	{
+		return index >= 0 && index < (int)distances_.Size() ? distances_[index] : FLOW_UNREACHABLE;
+	}
+
+	unsigned GetLastExpanded() const { return lastExpanded_; }
+	unsigned long long GetTotalExpanded() const { return totalExpanded_; }
+
+	int source_;
+
+	PODVector<unsigned> distances_;
+	PODVector<int> queue_;
+
+private:
+	bool HasSupport(const MazeGrid& grid, const GateBoard& board, int index) const;
+	bool PopEntry(FlowEntry& entry);
+
+	PODVector<FlowEntry> seeds_;
+	PODVector<FlowEntry> fifo_;
+	PODVector<int> invalidated_;
+	unsigned lastExpanded_;
+	unsigned long long totalExpanded_;
+	unsigned seedPos_;
+	unsigned fifoPos_;
+};
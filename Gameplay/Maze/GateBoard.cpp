@@ -0,0 +1,147 @@
+/*
+ * GateBoard.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+
+#include "GateBoard.h"
+
+GateBoard::GateBoard() :
+	width_(0),
+	height_(0),
+	wordsPerRow_(0),
+	tailMask_(0)
+{
+}
+
+void GateBoard::Resize(int width, int height)
+{
+	width_ = width;
+	height_ = height;
+	wordsPerRow_ = (width + CELLS_PER_GATE_WORD - 1) / CELLS_PER_GATE_WORD;
+
+	int tailCells = width % CELLS_PER_GATE_WORD;
+	tailMask_ = tailCells ? (1ULL << (tailCells * 4)) - 1ULL : ~0ULL;
+
+	words_.Resize(wordsPerRow_ * height_);
+	fixed_.Resize(wordsPerRow_ * height_);
+	dirtyRows_.Resize(height_);
+	dirtyRowList_.Clear();
+
+	for (int x = 0; x < height_; x++)
+	{
+		dirtyRows_[x] = 0;
+	}
+
+	for (unsigned x = 0; x < fixed_.Size(); x++)
+	{
+		fixed_[x] = 0;
+	}
+
+	Fill(0);
+}
+
+void GateBoard::SetMask(int index, unsigned mask)
+{
+	int wordIndex = GetWordIndex(index);
+	GateWord& word = words_[wordIndex];
+	int shift = GetShift(index);
+
+	word = (word & ~((GateWord)GATE_MASK_ALL << shift)) | ((GateWord)(mask & GATE_MASK_ALL) << shift) | fixed_[wordIndex];
+	MarkRowDirty(index / width_);
+}
+
+void GateBoard::XorMask(int index, unsigned mask)
+{
+	int wordIndex = GetWordIndex(index);
+
+	words_[wordIndex] = (words_[wordIndex] ^ ((GateWord)(mask & GATE_MASK_ALL) << GetShift(index))) | fixed_[wordIndex];
+	MarkRowDirty(index / width_);
+}
+
+void GateBoard::SetClosed(int index, CellSide side, bool closed)
+{
+	GateWord bit = 1ULL << (GetShift(index) + side);
+
+	if (closed)
+	{
+		words_[GetWordIndex(index)] |= bit;
+	}
+	else
+	{
+		words_[GetWordIndex(index)] &= ~bit | fixed_[GetWordIndex(index)];
+	}
+
+	MarkRowDirty(index / width_);
+}
+
+void GateBoard::SetFixed(int index, CellSide side)
+{
+	int wordIndex = GetWordIndex(index);
+	GateWord bit = 1ULL << (GetShift(index) + side);
+
+	fixed_[wordIndex] |= bit;
+	words_[wordIndex] |= bit;
+	MarkRowDirty(index / width_);
+}
+
+void GateBoard::FillRow(int row, unsigned mask)
+{
+	GateWord pattern = GATE_WORD_LOW_BITS * (mask & GATE_MASK_ALL);
+
+	for (int x = 0; x < wordsPerRow_; x++)
+	{
+		words_[row * wordsPerRow_ + x] = (pattern & GetRowWordMask(x)) | fixed_[row * wordsPerRow_ + x];
+	}
+
+	MarkRowDirty(row);
+}
+
+void GateBoard::Fill(unsigned mask)
+{
+	for (int x = 0; x < height_; x++)
+	{
+		FillRow(x, mask);
+	}
+}
+
+int GateBoard::FindOpen(CellSide side) const
+{
+	for (int row = 0; row < height_; row++)
+	{
+		for (int x = 0; x < wordsPerRow_; x++)
+		{
+			GateWord open = ~(words_[row * wordsPerRow_ + x] >> side) & GATE_WORD_LOW_BITS & GetRowWordMask(x);
+
+			if (!open)
+			{
+				continue;
+			}
+
+			int cell = 0;
+
+			while (!(open & 1ULL))
+			{
+				open >>= 4;
+				cell++;
+			}
+
+			return row * width_ + x * CELLS_PER_GATE_WORD + cell;
+		}
+	}
+
+	return NO_CELL;
+}
+
+void GateBoard::ClearDirty()
+{
+	for (unsigned x = 0; x < dirtyRowList_.Size(); x++)
+	{
+		dirtyRows_[dirtyRowList_[x]] = 0;
+	}
+
+	dirtyRowList_.Clear();
+}
@@ -0,0 +1,122 @@
+/*
+ * GateBoard.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+
+#include "MazeGrid.h"
+
+using namespace Urho3D;
+
+typedef unsigned long long GateWord;
+
+static const unsigned GATE_MASK_ALL = 0xF;
+static const int CELLS_PER_GATE_WORD = 16;
+//One set bit per cell of a word, on the nibble's lowest bit.
+static const GateWord GATE_WORD_LOW_BITS = 0x1111111111111111ULL;
+
+//Packed 4-bit wall mask per cell, bit n set when the gate on CellSide n is closed.
+//Each row of the maze is stored as a bitboard of 64-bit words holding 16 cells apiece,
+//padding bits past the last column are always zero. Rows written to are remembered until ClearDirty().
+//Fixed gates, the walls around a built maze, are kept in a second board of the same layout and stay closed
+//whatever is written over them.
+class GateBoard
+{
+public:
+	GateBoard();
+
+	void Resize(int width, int height);
+
+	unsigned GetMask(int index) const
+	{
+		return (unsigned)(words_[GetWordIndex(index)] >> GetShift(index)) & GATE_MASK_ALL;
+	}
+
+	void SetMask(int index, unsigned mask);
+	void XorMask(int index, unsigned mask);
+
+	bool IsClosed(int index, CellSide side) const
+	{
+		return (GetMask(index) & (1 << side)) != 0;
+	}
+
+	void SetClosed(int index, CellSide side, bool closed);
+
+	bool IsFixed(int index, CellSide side) const
+	{
+		return (GetFixedMask(index) & (1 << side)) != 0;
+	}
+
+	unsigned GetFixedMask(int index) const
+	{
+		return (unsigned)(fixed_[GetWordIndex(index)] >> GetShift(index)) & GATE_MASK_ALL;
+	}
+
+	//Closes the gate for good, nothing written to the board afterwards opens it.
+	void SetFixed(int index, CellSide side);
+
+	void FillRow(int row, unsigned mask);
+	void Fill(unsigned mask);
+
+	int FindOpen(CellSide side) const;
+
+	//Returns the neighbour on side when the gates on both sides of the passage are open.
+	int GetPassage(const MazeGrid& grid, int index, CellSide side) const
+	{
+		if (IsClosed(index, side))
+		{
+			return NO_CELL;
+		}
+
+		int neighbour = grid.GetNeighbour(index, side);
+
+		if (neighbour == NO_CELL || IsClosed(neighbour, MazeGrid::GetOppositeSide(side)))
+		{
+			return NO_CELL;
+		}
+
+		return neighbour;
+	}
+
+	void MarkRowDirty(int row)
+	{
+		if (!dirtyRows_[row])
+		{
+			dirtyRows_[row] = 1;
+			dirtyRowList_.Push(row);
+		}
+	}
+
+	void ClearDirty();
+
+	int GetWordIndex(int index) const
+	{
+		return (index / width_) * wordsPerRow_ + (index % width_) / CELLS_PER_GATE_WORD;
+	}
+
+	int GetShift(int index) const
+	{
+		return ((index % width_) % CELLS_PER_GATE_WORD) * 4;
+	}
+
+	GateWord GetRowWordMask(int wordInRow) const
+	{
+		return wordInRow == wordsPerRow_ - 1 ? tailMask_ : ~0ULL;
+	}
+
+	int width_;
+	int height_;
+	int wordsPerRow_;
+	GateWord tailMask_;
+
+	PODVector<GateWord> words_;
+	PODVector<GateWord> fixed_;
+	PODVector<unsigned char> dirtyRows_;
+	PODVector<int> dirtyRowList_;
+};
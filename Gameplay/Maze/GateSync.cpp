@@ -0,0 +1,61 @@
+/*
+ * GateSync.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+
+#include "GateSync.h"
+
+GateSync::GateSync() :
+	lastTouched_(0),
+	totalTouched_(0)
+{
+}
+
+void GateSync::Reset(const GateBoard& board)
+{
+	applied_ = board.words_;
+}
+
+unsigned GateSync::Collect(GateBoard& board, PODVector<int>& changedGates)
+{
+	changedGates.Clear();
+
+	for (unsigned x = 0; x < board.dirtyRowList_.Size(); x++)
+	{
+		int row = board.dirtyRowList_[x];
+
+		for (int y = 0; y < board.wordsPerRow_; y++)
+		{
+			int wordIndex = row * board.wordsPerRow_ + y;
+			GateWord diff = board.words_[wordIndex] ^ applied_[wordIndex];
+
+			if (!diff)
+			{
+				continue;
+			}
+
+			applied_[wordIndex] = board.words_[wordIndex];
+
+			int firstGate = (row * board.width_ + y * CELLS_PER_GATE_WORD) * MAX_CELL_SIDES;
+
+			for (int bit = 0; diff; bit++, diff >>= 1)
+			{
+				if (diff & 1ULL)
+				{
+					changedGates.Push(firstGate + bit);
+				}
+			}
+		}
+	}
+
+	board.ClearDirty();
+
+	lastTouched_ = changedGates.Size();
+	totalTouched_ += lastTouched_;
+
+	return lastTouched_;
+}
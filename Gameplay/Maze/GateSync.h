@@ -0,0 +1,35 @@
+/*
+ * GateSync.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+
+#include "GateBoard.h"
+
+using namespace Urho3D;
+
+//Remembers the gate state the scene is showing and hands out only the gates of the board that differ from it.
+class GateSync
+{
+public:
+	GateSync();
+
+	void Reset(const GateBoard& board);
+	unsigned Collect(GateBoard& board, PODVector<int>& changedGates);
+
+	//Gates handed out by the last Collect() and by every Collect() so far.
+	unsigned GetLastTouched() const { return lastTouched_; }
+	unsigned long long GetTotalTouched() const { return totalTouched_; }
+
+	PODVector<GateWord> applied_;
+
+private:
+	unsigned lastTouched_;
+	unsigned long long totalTouched_;
+};
@@ -0,0 +1,96 @@
+/*
+ * MazeBuilder.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Timer.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "MazeBuilder.h"
+#include "MazeGrid.h"
+#include "../Collision/EntityCategory.h"
+
+MazeBuilder::MazeBuilder() :
+	lastBuildMSec_(0)
+{
+}
+
+Node* MazeBuilder::Build(Node* cellsNode, int width, int height, MazeGrid& grid)
+{
+	if (!cellsNode || !cellsNode->GetNumChildren() || width < 1 || height < 1)
+	{
+		LOGERROR("MazeBuilder: nothing to build the maze from");
+		return cellsNode;
+	}
+
+	Timer buildTimer;
+
+	//The authored grid gives the corner and the cell size.
+	if (!grid.Build(cellsNode))
+	{
+		return cellsNode;
+	}
+
+	Vector3 origin = grid.origin_;
+	Vector2 cellSize = grid.cellSize_;
+
+	Node* scene = cellsNode->GetParent();
+	Node* prefab = cellsNode->GetChildren()[0];
+
+	Node* cells = scene->CreateChild(cellsNode->GetName());
+	cells->SetTransform(cellsNode->GetPosition(), cellsNode->GetRotation(), cellsNode->GetScale());
+	prefab->SetParent(cells);
+	cellsNode->Remove();
+
+	Node* walls = scene->GetChild("walls");
+
+	if (walls)
+	{
+		walls->Remove();
+	}
+
+	origin.y_ = prefab->GetWorldPosition().y_;
+
+	//Clones are appended next to the prefab, so the cells node only ever grows at the end.
+	for (int row = 0; row < height; row++)
+	{
+		for (int column = 0; column < width; column++)
+		{
+			Node* cell = row || column ? prefab->Clone(LOCAL) : prefab;
+			cell->SetWorldPosition(origin + Vector3(column * cellSize.x_, 0.0f, row * cellSize.y_));
+		}
+	}
+
+	if (!grid.Build(cells))
+	{
+		return cells;
+	}
+
+	for (int x = 0; x < grid.GetNumCells(); x++)
+	{
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
+		{
+			if (grid.GetNeighbour(x, (CellSide)y) != NO_CELL)
+			{
+				continue;
+			}
+
+			Node* gate = grid.GetCell(x)->GetChild(MazeGrid::GetGateName((CellSide)y));
+
+			if (gate)
+			{
+				SetEntityCategory(gate, CATEGORY_WALL);
+			}
+		}
+	}
+
+	lastBuildMSec_ = buildTimer.GetMSec(false);
+	LOGINFOF("MazeBuilder: built %d x %d cells in %u ms", width, height, lastBuildMSec_);
+
+	return cells;
+}
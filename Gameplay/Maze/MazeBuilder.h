@@ -0,0 +1,32 @@
+/*
+ * MazeBuilder.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+
+#include "MazeGrid.h"
+
+namespace Urho3D
+{
+class Node;
+}
+
+using namespace Urho3D;
+
+//Replaces the cells authored in the scene with a width x height grid cloned from the first of them, starting at
+//the corner the authored cells started from, and builds the grid over them. The authored walls only fit the
+//authored maze, so they are removed and the gates on the edge of the grid are tagged as walls instead.
+class MazeBuilder
+{
+public:
+	MazeBuilder();
+
+	Node* Build(Node* cellsNode, int width, int height, MazeGrid& grid);
+
+	unsigned lastBuildMSec_;
+};
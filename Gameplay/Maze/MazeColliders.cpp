@@ -0,0 +1,152 @@
+/*
+ * MazeColliders.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "MazeColliders.h"
+#include "../Collision/EntityCategory.h"
+
+MazeColliders::MazeColliders() :
+	chunkSize_(8)
+{
+}
+
+void MazeColliders::Build(Scene* scene, const MazeGrid& grid, const Vector<CellHandles>& cells, const GateBoard& board)
+{
+	if (root_)
+	{
+		root_->Remove();
+	}
+
+	root_ = scene->CreateChild("mazeColliders", LOCAL);
+
+	int numCells = grid.GetNumCells();
+	int chunksAcross = (grid.width_ + chunkSize_ - 1) / chunkSize_;
+	int chunksDown = (grid.height_ + chunkSize_ - 1) / chunkSize_;
+
+	chunkBodies_.Resize(chunksAcross * chunksDown);
+	dirtyChunks_.Resize(chunkBodies_.Size());
+	dirtyChunkList_.Clear();
+
+	for (unsigned x = 0; x < chunkBodies_.Size(); x++)
+	{
+		chunkBodies_[x] = 0;
+		dirtyChunks_[x] = 0;
+	}
+
+	gateShapes_.Resize(numCells * MAX_CELL_SIDES);
+	gateChunks_.Resize(numCells * MAX_CELL_SIDES);
+
+	unsigned numMoved = 0;
+
+	for (int x = 0; x < numCells; x++)
+	{
+		int chunk = (grid.GetColumn(x) / chunkSize_) + (grid.GetRow(x) / chunkSize_) * chunksAcross;
+
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
+		{
+			const GateHandles& gate = cells[x].gates_[y];
+			int gateIndex = x * MAX_CELL_SIDES + y;
+
+			gateShapes_[gateIndex] = 0;
+			gateChunks_[gateIndex] = chunk;
+
+			if (!gate.node_ || !gate.body_ || GetEntityCategory(gate.node_) == CATEGORY_WALL)
+			{
+				continue;
+			}
+
+			CollisionShape* source = gate.node_->GetComponent<CollisionShape>();
+
+			//Shapes that need a model would have to share it, those gates keep their own bodies.
+			if (!source || source->GetShapeType() == SHAPE_TRIANGLEMESH || source->GetShapeType() == SHAPE_CONVEXHULL
+					|| source->GetShapeType() == SHAPE_TERRAIN)
+			{
+				continue;
+			}
+
+			RigidBody* body = GetChunkBody(chunk, gate.body_);
+
+			//The chunk node sits at the origin, so the shape takes the gate's world transform as its offset.
+			CollisionShape* shape = body->GetNode()->CreateComponent<CollisionShape>(LOCAL);
+			shape->SetShapeType(source->GetShapeType());
+			shape->SetSize(source->GetSize() * gate.node_->GetWorldScale());
+			shape->SetPosition(gate.node_->GetWorldTransform() * source->GetPosition());
+			shape->SetRotation(gate.node_->GetWorldRotation() * source->GetRotation());
+			shape->SetMargin(source->GetMargin());
+			shape->SetEnabled(board.IsClosed(x, (CellSide)y));
+
+			gateShapes_[gateIndex] = shape;
+
+			gate.node_->RemoveComponent(source);
+			gate.node_->RemoveComponent(gate.body_);
+			numMoved++;
+		}
+	}
+
+	Flush();
+
+	LOGINFOF("MazeColliders: %u gates in %u chunk bodies", numMoved, chunkBodies_.Size());
+}
+
+bool MazeColliders::SetGateClosed(int index, CellSide side, bool closed)
+{
+	int gateIndex = index * MAX_CELL_SIDES + side;
+
+	if (gateIndex >= (int)gateShapes_.Size() || !gateShapes_[gateIndex])
+	{
+		return false;
+	}
+
+	MarkDirty(gateChunks_[gateIndex]);
+	gateShapes_[gateIndex]->SetEnabled(closed);
+
+	return true;
+}
+
+void MazeColliders::Flush()
+{
+	for (unsigned x = 0; x < dirtyChunkList_.Size(); x++)
+	{
+		int chunk = dirtyChunkList_[x];
+		dirtyChunks_[chunk] = 0;
+		chunkBodies_[chunk]->EnableMassUpdate();
+	}
+
+	dirtyChunkList_.Clear();
+}
+
+RigidBody* MazeColliders::GetChunkBody(int chunk, RigidBody* source)
+{
+	if (!chunkBodies_[chunk])
+	{
+		RigidBody* body = root_->CreateChild("chunk", LOCAL)->CreateComponent<RigidBody>(LOCAL);
+		body->SetCollisionLayerAndMask(source->GetCollisionLayer(), source->GetCollisionMask());
+		body->SetFriction(source->GetFriction());
+		body->SetRestitution(source->GetRestitution());
+		chunkBodies_[chunk] = body;
+	}
+
+	MarkDirty(chunk);
+
+	return chunkBodies_[chunk];
+}
+
+void MazeColliders::MarkDirty(int chunk)
+{
+	if (!dirtyChunks_[chunk])
+	{
+		dirtyChunks_[chunk] = 1;
+		dirtyChunkList_.Push(chunk);
+		chunkBodies_[chunk]->DisableMassUpdate();
+	}
+}
@@ -0,0 +1,59 @@
+/*
+ * MazeColliders.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/Vector.h>
+
+#include "GateBoard.h"
+#include "MazeGrid.h"
+#include "../Handles/SceneHandles.h"
+
+namespace Urho3D
+{
+class CollisionShape;
+class Node;
+class RigidBody;
+class Scene;
+}
+
+using namespace Urho3D;
+
+//Moves the gate colliders into one static compound body per square chunk of chunkSize_ cells, so the broadphase
+//holds a proxy per chunk instead of one per gate. A closed gate is an enabled child shape and an open gate a
+//disabled one, which only edits the chunk's compound. Mass updates are held back until Flush(), so a batch of
+//changes costs one update per chunk touched. Gates tagged as walls keep their own bodies so collisions with them
+//can still tell which node was hit.
+class MazeColliders
+{
+public:
+	MazeColliders();
+
+	void Build(Scene* scene, const MazeGrid& grid, const Vector<CellHandles>& cells, const GateBoard& board);
+	bool SetGateClosed(int index, CellSide side, bool closed);
+	void Flush();
+
+	bool IsBuilt() const { return root_.NotNull(); }
+	unsigned GetNumChunks() const { return chunkBodies_.Size(); }
+
+	int chunkSize_;
+
+private:
+	RigidBody* GetChunkBody(int chunk, RigidBody* source);
+	void MarkDirty(int chunk);
+
+	SharedPtr<Node> root_;
+
+	PODVector<RigidBody*> chunkBodies_;
+	PODVector<unsigned char> dirtyChunks_;
+	PODVector<int> dirtyChunkList_;
+
+	PODVector<CollisionShape*> gateShapes_;
+	PODVector<int> gateChunks_;
+};
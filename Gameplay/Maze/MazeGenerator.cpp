@@ -0,0 +1,124 @@
+/*
+ * MazeGenerator.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+
+#include "MazeGenerator.h"
+
+//An edge joins a cell to its neighbour on the Bottom (+x) side when even, on the Right (+z) side when odd.
+static const CellSide edgeSides[] = { SIDE_BOTTOM, SIDE_RIGHT };
+
+MazeGenerator::MazeGenerator() :
+	loopChance_(0.15f),
+	state_(1)
+{
+}
+
+void MazeGenerator::Generate(const MazeGrid& grid, GateBoard& board, unsigned seed)
+{
+	int numCells = grid.GetNumCells();
+
+	//xorshift must not start from zero, scramble the seed so nearby seeds give unrelated mazes.
+	state_ = (seed ^ 0x9E3779B9U) * 0x85EBCA6BU;
+
+	if (!state_)
+	{
+		state_ = 1;
+	}
+
+	board.Fill(GATE_MASK_ALL);
+
+	edges_.Clear();
+	edges_.Reserve(numCells * 2);
+	parents_.Resize(numCells);
+	sizes_.Resize(numCells);
+
+	for (int x = 0; x < numCells; x++)
+	{
+		parents_[x] = x;
+		sizes_[x] = 1;
+
+		if (!grid.IsValid(x))
+		{
+			continue;
+		}
+
+		for (int y = 0; y < 2; y++)
+		{
+			if (grid.GetNeighbour(x, edgeSides[y]) != NO_CELL)
+			{
+				edges_.Push(x * 2 + y);
+			}
+		}
+	}
+
+	for (int x = (int)edges_.Size() - 1; x > 0; x--)
+	{
+		int y = (int)(NextRandom() % (unsigned)(x + 1));
+		int edge = edges_[x];
+		edges_[x] = edges_[y];
+		edges_[y] = edge;
+	}
+
+	unsigned loopThreshold = (unsigned)(loopChance_ * 65536.0f);
+
+	for (unsigned x = 0; x < edges_.Size(); x++)
+	{
+		int cell = edges_[x] / 2;
+		CellSide side = edgeSides[edges_[x] % 2];
+		int neighbour = grid.GetNeighbour(cell, side);
+
+		if (UnionSets(cell, neighbour) || (NextRandom() & 0xFFFF) < loopThreshold)
+		{
+			board.SetClosed(cell, side, false);
+			board.SetClosed(neighbour, MazeGrid::GetOppositeSide(side), false);
+		}
+	}
+}
+
+unsigned MazeGenerator::NextRandom()
+{
+	state_ ^= state_ << 13;
+	state_ ^= state_ >> 17;
+	state_ ^= state_ << 5;
+
+	return state_;
+}
+
+int MazeGenerator::FindSet(int index)
+{
+	while (parents_[index] != index)
+	{
+		parents_[index] = parents_[parents_[index]];
+		index = parents_[index];
+	}
+
+	return index;
+}
+
+bool MazeGenerator::UnionSets(int a, int b)
+{
+	a = FindSet(a);
+	b = FindSet(b);
+
+	if (a == b)
+	{
+		return false;
+	}
+
+	if (sizes_[a] < sizes_[b])
+	{
+		int temp = a;
+		a = b;
+		b = temp;
+	}
+
+	parents_[b] = a;
+	sizes_[a] += sizes_[b];
+
+	return true;
+}
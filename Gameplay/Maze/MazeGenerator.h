@@ -0,0 +1,39 @@
+/*
+ * MazeGenerator.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+
+#include "GateBoard.h"
+#include "MazeGrid.h"
+
+using namespace Urho3D;
+
+//Randomized Kruskal over the grid: every passage of a spanning tree is opened, so each cell can reach every other,
+//plus a share of the remaining passages to give the maze loops. The same seed always gives the same maze.
+class MazeGenerator
+{
+public:
+	MazeGenerator();
+
+	void Generate(const MazeGrid& grid, GateBoard& board, unsigned seed);
+
+	float loopChance_;
+
+private:
+	unsigned NextRandom();
+	int FindSet(int index);
+	bool UnionSets(int a, int b);
+
+	unsigned state_;
+
+	PODVector<int> edges_;
+	PODVector<int> parents_;
+	PODVector<int> sizes_;
+};
@@ -0,0 +1,188 @@
+/*
+ * MazeGrid.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Math/BoundingBox.h>
+#include <Urho3D/Physics/CollisionShape.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Math/MathDefs.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Math/Plane.h>
+
+#include <cmath>
+
+#include "MazeGrid.h"
+
+static const int sideColumnOffsets[] = { -1, 1, 0, 0 };
+static const int sideRowOffsets[] = { 0, 0, -1, 1 };
+static const char* gateNames[] = { "closedTop", "closedBottom", "closedLeft", "closedRight" };
+
+static int RoundToCell(float value)
+{
+	return (int)floorf(value + 0.5f);
+}
+
+MazeGrid::MazeGrid()
+{
+	Clear();
+}
+
+void MazeGrid::Clear()
+{
+	width_ = 0;
+	height_ = 0;
+	origin_ = Vector3::ZERO;
+	cellSize_ = Vector2::ONE;
+	floorHeight_ = 0.0f;
+	cells_.Clear();
+	gateBounds_.Clear();
+}
+
+bool MazeGrid::Build(Node* cellsNode)
+{
+	Clear();
+
+	if (!cellsNode || !cellsNode->GetNumChildren())
+	{
+		return false;
+	}
+
+	const Vector<SharedPtr<Node> >& children = cellsNode->GetChildren();
+
+	CollisionShape* shape = children[0]->GetComponent<CollisionShape>();
+
+	if (!shape)
+	{
+		LOGERROR("MazeGrid: cell has no CollisionShape to take its size from");
+		return false;
+	}
+
+	cellSize_ = Vector2(shape->GetSize().x_, shape->GetSize().z_);
+	floorHeight_ = shape->GetWorldBoundingBox().max_.y_;
+
+	Vector2 minPos(M_INFINITY, M_INFINITY);
+	Vector2 maxPos(-M_INFINITY, -M_INFINITY);
+
+	for (unsigned x = 0; x < children.Size(); x++)
+	{
+		Vector3 pos = children[x]->GetWorldPosition();
+		minPos.x_ = Min(minPos.x_, pos.x_);
+		minPos.y_ = Min(minPos.y_, pos.z_);
+		maxPos.x_ = Max(maxPos.x_, pos.x_);
+		maxPos.y_ = Max(maxPos.y_, pos.z_);
+	}
+
+	origin_ = Vector3(minPos.x_, children[0]->GetWorldPosition().y_, minPos.y_);
+	width_ = RoundToCell((maxPos.x_ - minPos.x_) / cellSize_.x_) + 1;
+	height_ = RoundToCell((maxPos.y_ - minPos.y_) / cellSize_.y_) + 1;
+
+	cells_.Resize(width_ * height_);
+
+	for (unsigned x = 0; x < cells_.Size(); x++)
+	{
+		cells_[x] = NULL;
+	}
+
+	for (unsigned x = 0; x < children.Size(); x++)
+	{
+		Vector3 pos = children[x]->GetWorldPosition();
+		int index = GetIndex(RoundToCell((pos.x_ - origin_.x_) / cellSize_.x_),
+				RoundToCell((pos.z_ - origin_.z_) / cellSize_.y_));
+
+		if (cells_[index])
+		{
+			LOGERROR("MazeGrid: cells do not form a regular grid");
+			Clear();
+			return false;
+		}
+
+		cells_[index] = children[x];
+	}
+
+	//Gates never move, so their bounds are only read once.
+	gateBounds_.Resize(cells_.Size() * MAX_CELL_SIDES);
+
+	for (unsigned x = 0; x < cells_.Size(); x++)
+	{
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
+		{
+			Node* gate = cells_[x] ? cells_[x]->GetChild(gateNames[y]) : NULL;
+			CollisionShape* gateShape = gate ? gate->GetComponent<CollisionShape>() : NULL;
+
+			gateBounds_[x * MAX_CELL_SIDES + y] = gateShape ? gateShape->GetWorldBoundingBox() : BoundingBox();
+		}
+	}
+
+	return true;
+}
+
+int MazeGrid::GetCellIndex(const Vector3& worldPos) const
+{
+	int column = RoundToCell((worldPos.x_ - origin_.x_) / cellSize_.x_);
+	int row = RoundToCell((worldPos.z_ - origin_.z_) / cellSize_.y_);
+
+	if (column < 0 || column >= width_ || row < 0 || row >= height_)
+	{
+		return NO_CELL;
+	}
+
+	int index = GetIndex(column, row);
+
+	return cells_[index] ? index : NO_CELL;
+}
+
+int MazeGrid::PickCell(const Ray& ray) const
+{
+	float distance = ray.HitDistance(Plane(Vector3::UP, Vector3(0.0f, floorHeight_, 0.0f)));
+
+	if (distance == M_INFINITY)
+	{
+		return NO_CELL;
+	}
+
+	return GetCellIndex(ray.origin_ + ray.direction_ * distance);
+}
+
+int MazeGrid::GetNeighbour(int index, CellSide side) const
+{
+	if (index == NO_CELL)
+	{
+		return NO_CELL;
+	}
+
+	int column = GetColumn(index) + sideColumnOffsets[side];
+	int row = GetRow(index) + sideRowOffsets[side];
+
+	if (column < 0 || column >= width_ || row < 0 || row >= height_)
+	{
+		return NO_CELL;
+	}
+
+	int neighbour = GetIndex(column, row);
+
+	return cells_[neighbour] ? neighbour : NO_CELL;
+}
+
+Node* MazeGrid::GetCell(int index) const
+{
+	return IsValid(index) ? cells_[index] : NULL;
+}
+
+Vector3 MazeGrid::GetCellPosition(int index) const
+{
+	return origin_ + Vector3(GetColumn(index) * cellSize_.x_, 0.0f, GetRow(index) * cellSize_.y_);
+}
+
+CellSide MazeGrid::GetOppositeSide(CellSide side)
+{
+	return (CellSide)(side ^ 1);
+}
+
+const char* MazeGrid::GetGateName(CellSide side)
+{
+	return gateNames[side];
+}
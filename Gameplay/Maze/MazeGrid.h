@@ -0,0 +1,74 @@
+/*
+ * MazeGrid.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Math/BoundingBox.h>
+#include <Urho3D/Math/Ray.h>
+#include <Urho3D/Math/Vector2.h>
+#include <Urho3D/Math/Vector3.h>
+
+namespace Urho3D
+{
+class Node;
+}
+
+using namespace Urho3D;
+
+//Sides are named after the gate nodes of a cell. In the scene Top faces -x, Bottom faces +x,
+//Left faces -z and Right faces +z.
+enum CellSide
+{
+	SIDE_TOP = 0,
+	SIDE_BOTTOM,
+	SIDE_LEFT,
+	SIDE_RIGHT,
+	MAX_CELL_SIDES
+};
+
+static const int NO_CELL = -1;
+
+//Position to cell and neighbour lookups for the maze, built once from the children of the cells node.
+class MazeGrid
+{
+public:
+	MazeGrid();
+
+	bool Build(Node* cellsNode);
+	void Clear();
+
+	int GetCellIndex(const Vector3& worldPos) const;
+	int PickCell(const Ray& ray) const;
+	int GetNeighbour(int index, CellSide side) const;
+	Node* GetCell(int index) const;
+	Vector3 GetCellPosition(int index) const;
+
+	const BoundingBox& GetGateBounds(int index, CellSide side) const
+	{
+		return gateBounds_[index * MAX_CELL_SIDES + side];
+	}
+
+	int GetNumCells() const { return width_ * height_; }
+	int GetColumn(int index) const { return index % width_; }
+	int GetRow(int index) const { return index / width_; }
+	int GetIndex(int column, int row) const { return row * width_ + column; }
+	bool IsValid(int index) const { return index >= 0 && index < (int)cells_.Size() && cells_[index]; }
+
+	static CellSide GetOppositeSide(CellSide side);
+	static const char* GetGateName(CellSide side);
+
+	int width_;
+	int height_;
+	Vector3 origin_;
+	Vector2 cellSize_;
+	float floorHeight_;
+
+	PODVector<Node*> cells_;
+	PODVector<BoundingBox> gateBounds_;
+};
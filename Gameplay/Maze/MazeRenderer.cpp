@@ -0,0 +1,156 @@
+/*
+ * MazeRenderer.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Graphics/Model.h>
+#include <Urho3D/Graphics/StaticModel.h>
+#include <Urho3D/Graphics/StaticModelGroup.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Scene/Node.h>
+#include <Urho3D/Scene/Scene.h>
+
+#include "MazeRenderer.h"
+
+MazeRenderer::MazeRenderer() :
+	chunkSize_(16),
+	numGroups_(0)
+{
+}
+
+void MazeRenderer::Build(Scene* scene, const MazeGrid& grid, const Vector<CellHandles>& cells, const GateBoard& board)
+{
+	if (root_)
+	{
+		root_->Remove();
+	}
+
+	root_ = scene->CreateChild("mazeChunks", LOCAL);
+	numGroups_ = 0;
+
+	int numCells = grid.GetNumCells();
+	int chunksAcross = (grid.width_ + chunkSize_ - 1) / chunkSize_;
+	int chunksDown = (grid.height_ + chunkSize_ - 1) / chunkSize_;
+
+	PODVector<Node*> chunks;
+	chunks.Resize(chunksAcross * chunksDown);
+
+	for (unsigned x = 0; x < chunks.Size(); x++)
+	{
+		chunks[x] = root_->CreateChild("chunk", LOCAL);
+	}
+
+	gateNodes_.Resize(numCells * MAX_CELL_SIDES);
+	closedGroups_.Resize(numCells * MAX_CELL_SIDES);
+	openGroups_.Resize(numCells * MAX_CELL_SIDES);
+
+	PODVector<StaticModel*> models;
+
+	for (int x = 0; x < numCells; x++)
+	{
+		Node* chunk = chunks[(grid.GetColumn(x) / chunkSize_) + (grid.GetRow(x) / chunkSize_) * chunksAcross];
+
+		if (cells[x].node_)
+		{
+			cells[x].node_->GetComponents<StaticModel>(models, false);
+
+			for (unsigned y = 0; y < models.Size(); y++)
+			{
+				StaticModelGroup* group = GetGroup(chunk, models[y]);
+
+				if (group)
+				{
+					group->AddInstanceNode(cells[x].node_);
+					models[y]->SetEnabled(false);
+				}
+			}
+		}
+
+		for (int y = 0; y < MAX_CELL_SIDES; y++)
+		{
+			const GateHandles& gate = cells[x].gates_[y];
+			int gateIndex = x * MAX_CELL_SIDES + y;
+
+			gateNodes_[gateIndex] = 0;
+			closedGroups_[gateIndex] = 0;
+			openGroups_[gateIndex] = 0;
+
+			if (!gate.IsValid())
+			{
+				continue;
+			}
+
+			gateNodes_[gateIndex] = gate.node_;
+			closedGroups_[gateIndex] = GetGroup(chunk, gate.closedModel_);
+			openGroups_[gateIndex] = GetGroup(chunk, gate.openModel_);
+			gate.closedModel_->SetEnabled(false);
+			gate.openModel_->SetEnabled(false);
+
+			StaticModelGroup* group = board.IsClosed(x, (CellSide)y) ? closedGroups_[gateIndex] : openGroups_[gateIndex];
+
+			if (group)
+			{
+				group->AddInstanceNode(gate.node_);
+			}
+		}
+	}
+
+	LOGINFOF("MazeRenderer: %d cells in %u chunks, %u groups", numCells, chunks.Size(), numGroups_);
+}
+
+void MazeRenderer::SetGateClosed(int index, CellSide side, bool closed)
+{
+	int gateIndex = index * MAX_CELL_SIDES + side;
+	Node* node = gateNodes_[gateIndex];
+
+	if (!node)
+	{
+		return;
+	}
+
+	StaticModelGroup* from = closed ? openGroups_[gateIndex] : closedGroups_[gateIndex];
+	StaticModelGroup* to = closed ? closedGroups_[gateIndex] : openGroups_[gateIndex];
+
+	if (from)
+	{
+		from->RemoveInstanceNode(node);
+	}
+
+	if (to)
+	{
+		to->AddInstanceNode(node);
+	}
+}
+
+StaticModelGroup* MazeRenderer::GetGroup(Node* chunk, StaticModel* model)
+{
+	if (!model || !model->GetModel())
+	{
+		return 0;
+	}
+
+	Material* material = model->GetMaterial(0);
+	const Vector<SharedPtr<Component> >& components = chunk->GetComponents();
+
+	for (unsigned x = 0; x < components.Size(); x++)
+	{
+		StaticModelGroup* group = static_cast<StaticModelGroup*>(components[x].Get());
+
+		if (group->GetModel() == model->GetModel() && group->GetMaterial(0) == material)
+		{
+			return group;
+		}
+	}
+
+	StaticModelGroup* group = chunk->CreateComponent<StaticModelGroup>(LOCAL);
+	group->SetModel(model->GetModel());
+	group->SetMaterial(material);
+	group->SetCastShadows(model->GetCastShadows());
+	group->SetViewMask(model->GetViewMask());
+	numGroups_++;
+
+	return group;
+}
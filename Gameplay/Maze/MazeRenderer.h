@@ -0,0 +1,54 @@
+/*
+ * MazeRenderer.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/Vector.h>
+
+#include "GateBoard.h"
+#include "MazeGrid.h"
+#include "../Handles/SceneHandles.h"
+
+namespace Urho3D
+{
+class Node;
+class Scene;
+class StaticModel;
+class StaticModelGroup;
+}
+
+using namespace Urho3D;
+
+//Draws the floors and gates of the maze through StaticModelGroups, one per model and material in each square
+//chunk of chunkSize_ cells so chunks off screen are still culled. The StaticModels the cells were authored with
+//are disabled and their nodes become group instances. A gate changing state only moves its node from the closed
+//group of its chunk to the open one or back.
+class MazeRenderer
+{
+public:
+	MazeRenderer();
+
+	void Build(Scene* scene, const MazeGrid& grid, const Vector<CellHandles>& cells, const GateBoard& board);
+	void SetGateClosed(int index, CellSide side, bool closed);
+
+	bool IsBuilt() const { return root_.NotNull(); }
+	unsigned GetNumGroups() const { return numGroups_; }
+
+	int chunkSize_;
+
+private:
+	StaticModelGroup* GetGroup(Node* chunk, StaticModel* model);
+
+	SharedPtr<Node> root_;
+	unsigned numGroups_;
+
+	PODVector<Node*> gateNodes_;
+	PODVector<StaticModelGroup*> closedGroups_;
+	PODVector<StaticModelGroup*> openGroups_;
+};
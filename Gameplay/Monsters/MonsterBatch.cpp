@@ -0,0 +1,89 @@
+/*
+ * MonsterBatch.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "MonsterBatch.h"
+#include "../LogicComponents/RigidBodyMoveTo.h"
+
+MonsterBatch::MonsterBatch()
+{
+}
+
+void MonsterBatch::Add(Node* monster)
+{
+	nodes_.Push(monster);
+	bodies_.Push(monster->GetComponent<RigidBody>());
+	movers_.Push(monster->GetComponent<RigidBodyMoveTo>());
+	positions_.Push(monster->GetPosition());
+	cells_.Push(NO_CELL);
+	queued_.Push(0);
+}
+
+bool MonsterBatch::Remove(Node* monster)
+{
+	int slot = Find(monster);
+
+	if (slot < 0)
+	{
+		return false;
+	}
+
+	unsigned last = nodes_.Size() - 1;
+
+	nodes_[slot] = nodes_[last];
+	bodies_[slot] = bodies_[last];
+	movers_[slot] = movers_[last];
+	positions_[slot] = positions_[last];
+	cells_[slot] = cells_[last];
+	queued_[slot] = queued_[last];
+
+	nodes_.Resize(last);
+	bodies_.Resize(last);
+	movers_.Resize(last);
+	positions_.Resize(last);
+	cells_.Resize(last);
+	queued_.Resize(last);
+
+	return true;
+}
+
+int MonsterBatch::Find(Node* monster) const
+{
+	for (unsigned x = 0; x < nodes_.Size(); x++)
+	{
+		if (nodes_[x] == monster)
+		{
+			return x;
+		}
+	}
+
+	return -1;
+}
+
+void MonsterBatch::Gather(const MazeGrid& grid)
+{
+	for (unsigned x = 0; x < bodies_.Size(); x++)
+	{
+		//Kinematic pets are placed through their node, the body only catches up on the next step.
+		positions_[x] = movers_[x]->kinematic_ ? nodes_[x]->GetWorldPosition() : bodies_[x]->GetPosition();
+		cells_[x] = grid.GetCellIndex(positions_[x]);
+		queued_[x] = movers_[x]->GetNumWaypoints() > 0;
+	}
+}
+
+void MonsterBatch::Clear()
+{
+	nodes_.Clear();
+	bodies_.Clear();
+	movers_.Clear();
+	positions_.Clear();
+	cells_.Clear();
+	queued_.Clear();
+}
@@ -0,0 +1,49 @@
+/*
+ * MonsterBatch.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Math/Vector3.h>
+
+#include "../Maze/MazeGrid.h"
+
+namespace Urho3D
+{
+class Node;
+class RigidBody;
+}
+
+class RigidBodyMoveTo;
+
+using namespace Urho3D;
+
+//Spawned pets as parallel arrays indexed by slot. Components are resolved once when a pet is added and
+//Gather() reads every position and cell in one pass, so the AI stage works from plain data.
+//Removing swaps the last slot into the hole.
+class MonsterBatch
+{
+public:
+	MonsterBatch();
+
+	void Add(Node* monster);
+	bool Remove(Node* monster);
+	int Find(Node* monster) const;
+	void Gather(const MazeGrid& grid);
+	void Clear();
+
+	unsigned Size() const { return nodes_.Size(); }
+
+	PODVector<Node*> nodes_;
+	PODVector<RigidBody*> bodies_;
+	PODVector<RigidBodyMoveTo*> movers_;
+	PODVector<Vector3> positions_;
+	PODVector<int> cells_;
+	//Pets still walking a path they were handed, the AI leaves them be.
+	PODVector<unsigned char> queued_;
+};
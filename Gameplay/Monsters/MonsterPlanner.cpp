@@ -0,0 +1,177 @@
+/*
+ * MonsterPlanner.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Math/MathDefs.h>
+
+#include "MonsterPlanner.h"
+#include "../Trace/TraceRecorder.h"
+
+MonsterPlanner::MonsterPlanner() :
+	minBatch_(32),
+	pathLength_(4),
+	grid_(0),
+	board_(0),
+	flowField_(0),
+	batch_(0)
+{
+}
+
+void MonsterPlanner::Plan(WorkQueue* queue, const MazeGrid& grid, const GateBoard& board, const FlowField& flowField,
+		const MonsterBatch& batch, const Vector3& archerPos, unsigned start, unsigned count)
+{
+	commands_.Resize(batch.Size());
+
+	if (!count)
+	{
+		return;
+	}
+
+	grid_ = &grid;
+	board_ = &board;
+	flowField_ = &flowField;
+	batch_ = &batch;
+	archerPos_ = archerPos;
+
+	unsigned numThreads = queue ? queue->GetNumThreads() + 1 : 1;
+	unsigned rangeSize = Max((count + numThreads - 1) / numThreads, minBatch_);
+
+	if (!queue || rangeSize >= count)
+	{
+		for (unsigned x = start; x < start + count; x++)
+		{
+			PlanMonster(x);
+		}
+
+		return;
+	}
+
+	//Items are kept between ticks and handed back to the queue each time.
+	unsigned numItems = (count + rangeSize - 1) / rangeSize;
+
+	while (items_.Size() < numItems)
+	{
+		SharedPtr<WorkItem> item(new WorkItem());
+		item->workFunction_ = PlanWork;
+		item->aux_ = this;
+		items_.Push(item);
+	}
+
+	MonsterCommand* commands = &commands_[start];
+
+	for (unsigned x = 0; x < numItems; x++)
+	{
+		WorkItem* item = items_[x];
+		item->start_ = commands + x * rangeSize;
+		item->end_ = commands + Min((x + 1) * rangeSize, count);
+		item->priority_ = M_MAX_UNSIGNED;
+		queue->AddWorkItem(item);
+	}
+
+	queue->Complete(M_MAX_UNSIGNED);
+}
+
+void MonsterPlanner::PlanWork(const WorkItem* item, unsigned threadIndex)
+{
+	TRACE("PlanMonsters");
+
+	MonsterPlanner* planner = reinterpret_cast<MonsterPlanner*>(item->aux_);
+	MonsterCommand* commands = &planner->commands_[0];
+	unsigned start = (unsigned)(reinterpret_cast<MonsterCommand*>(item->start_) - commands);
+	unsigned end = (unsigned)(reinterpret_cast<MonsterCommand*>(item->end_) - commands);
+
+	for (unsigned x = start; x < end; x++)
+	{
+		planner->PlanMonster(x);
+	}
+}
+
+void MonsterPlanner::PlanMonster(unsigned slot)
+{
+	MonsterCommand& command = commands_[slot];
+	command.type_ = MONSTER_IDLE;
+	command.pathLength_ = 0;
+
+	int monsterIndex = batch_->cells_[slot];
+
+	if (monsterIndex == NO_CELL || batch_->queued_[slot])
+	{
+		return;
+	}
+
+	unsigned distance = flowField_->GetDistance(monsterIndex);
+
+	if (distance == 0)//Already in the archer's cell.
+	{
+		return;
+	}
+
+	if (distance != FLOW_UNREACHABLE)
+	{
+		for (int x = 0; x < MAX_CELL_SIDES; x++)
+		{
+			int neighbour = board_->GetPassage(*grid_, monsterIndex, (CellSide)x);
+
+			if (neighbour != NO_CELL && flowField_->GetDistance(neighbour) == distance - 1)
+			{
+				command.type_ = MONSTER_STEP;
+				command.side_ = (unsigned char)x;
+				command.path_[command.pathLength_++] = neighbour;
+
+				//Carry on down the field so the pet isn't planned again every cell.
+				unsigned maxLength = Clamp(pathLength_, 1U, MAX_MONSTER_PATH);
+				int index = neighbour;
+
+				while (command.pathLength_ < maxLength)
+				{
+					index = flowField_->GetNextStep(*grid_, *board_, index);
+
+					if (index == NO_CELL)
+					{
+						break;
+					}
+
+					command.path_[command.pathLength_++] = index;
+				}
+
+				return;
+			}
+		}
+
+		return;
+	}
+
+	//No open path to the archer, head straight for it.
+	const Vector3& monsterPos = batch_->positions_[slot];
+	float xDist = Abs(monsterPos.x_ - archerPos_.x_);
+	float zDist = Abs(monsterPos.z_ - archerPos_.z_);
+
+	CellSide side;
+
+	if (xDist > zDist)
+	{
+		side = monsterPos.x_ < archerPos_.x_ ? SIDE_BOTTOM : SIDE_TOP;
+	}
+	else if (zDist > 0.0f)
+	{
+		side = monsterPos.z_ < archerPos_.z_ ? SIDE_RIGHT : SIDE_LEFT;
+	}
+	else
+	{
+		return;
+	}
+
+	int nextIndex = grid_->GetNeighbour(monsterIndex, side);
+
+	if (nextIndex != NO_CELL)
+	{
+		command.type_ = MONSTER_CHASE;
+		command.side_ = (unsigned char)side;
+		command.path_[command.pathLength_++] = nextIndex;
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * MonsterPlanner.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Core/WorkQueue.h>
+#include <Urho3D/Math/Vector3.h>
+
+#include "MonsterBatch.h"
+#include "../Maze/FlowField.h"
+#include "../Maze/GateBoard.h"
+#include "../Maze/MazeGrid.h"
+
+using namespace Urho3D;
+
+//Most cells of the flow field handed to a pet at once.
+static const unsigned MAX_MONSTER_PATH = 8;
+
+enum MonsterCommandType
+{
+	MONSTER_IDLE = 0,
+	MONSTER_STEP,//Follow an open passage of the flow field.
+	MONSTER_CHASE//No open path, take the gates between the cells from elsewhere.
+};
+
+struct MonsterCommand
+{
+	unsigned char type_;
+	unsigned char side_;
+	unsigned char pathLength_;
+	//Cells to walk through in order, the first is the neighbour through side_.
+	int path_[MAX_MONSTER_PATH];
+};
+
+//Decides where pets head next from read-only maze data. The slots asked for are split into ranges run on the
+//work queue, each writing only its own commands, and the main thread applies the commands afterwards.
+class MonsterPlanner
+{
+public:
+	MonsterPlanner();
+
+	//Plans slots start to start + count, the commands of other slots are left as they were.
+	void Plan(WorkQueue* queue, const MazeGrid& grid, const GateBoard& board, const FlowField& flowField,
+			const MonsterBatch& batch, const Vector3& archerPos, unsigned start, unsigned count);
+
+	//Fewest slots worth a Plan() call, enough to give every thread a full range.
+	unsigned GetChunkSize(WorkQueue* queue) const
+	{
+		return minBatch_ * (queue ? queue->GetNumThreads() + 1 : 1);
+	}
+
+	PODVector<MonsterCommand> commands_;
+	//Pets planned per work item, below this many the main thread plans alone.
+	unsigned minBatch_;
+	//Cells of a step command, pets follow them before being planned again. Chases are always one cell.
+	unsigned pathLength_;
+
+private:
+	static void PlanWork(const WorkItem* item, unsigned threadIndex);
+	void PlanMonster(unsigned slot);
+
+	Vector<SharedPtr<WorkItem> > items_;
+
+	const MazeGrid* grid_;
+	const GateBoard* board_;
+	const FlowField* flowField_;
+	const MonsterBatch* batch_;
+	Vector3 archerPos_;
+};
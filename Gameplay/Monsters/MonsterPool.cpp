@@ -0,0 +1,128 @@
+/*
+ * MonsterPool.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/Physics/RigidBody.h>
+#include <Urho3D/Scene/Node.h>
+
+#include "MonsterPool.h"
+#include "../LogicComponents/RigidBodyMoveTo.h"
+
+static const StringHash VAR_MONSTERTYPE("MonsterType");
+
+MonsterPool::MonsterPool() :
+	kinematic_(false),
+	hits_(0),
+	fallbacks_(0),
+	misses_(0),
+	context_(0)
+{
+}
+
+void MonsterPool::Build(Context* context, const Vector<Node*>& prototypes, int capacity)
+{
+	Clear();
+
+	context_ = context;
+	prototypes_ = prototypes;
+	free_.Resize(prototypes_.Size());
+
+	if (prototypes_.Empty())
+	{
+		return;
+	}
+
+	int perType = (capacity + (int)prototypes_.Size() - 1) / (int)prototypes_.Size();
+
+	for (unsigned x = 0; x < prototypes_.Size(); x++)
+	{
+		for (int y = 0; y < perType; y++)
+		{
+			Release(Create(x));
+		}
+	}
+}
+
+Node* MonsterPool::Acquire(int type)
+{
+	Node* monster = 0;
+
+	if (!free_[type].Empty())
+	{
+		hits_++;
+		monster = free_[type].Back();
+		free_[type].Pop();
+	}
+	else
+	{
+		for (unsigned x = 0; x < free_.Size() && !monster; x++)
+		{
+			if (!free_[x].Empty())
+			{
+				fallbacks_++;
+				monster = free_[x].Back();
+				free_[x].Pop();
+			}
+		}
+	}
+
+	if (!monster)
+	{
+		misses_++;
+		return Create(type);
+	}
+
+	monster->SetEnabledRecursive(true);
+
+	return monster;
+}
+
+void MonsterPool::Release(Node* monster)
+{
+	monster->GetComponent<RigidBodyMoveTo>()->Stop();
+	monster->SetEnabledRecursive(false);
+
+	free_[monster->GetVar(VAR_MONSTERTYPE).GetInt()].Push(monster);
+}
+
+void MonsterPool::Clear()
+{
+	for (unsigned x = 0; x < free_.Size(); x++)
+	{
+		for (unsigned y = 0; y < free_[x].Size(); y++)
+		{
+			free_[x][y]->Remove();
+		}
+	}
+
+	free_.Clear();
+	prototypes_.Clear();
+}
+
+void MonsterPool::TakeCounters(unsigned& hits, unsigned& fallbacks, unsigned& misses)
+{
+	hits += hits_;
+	fallbacks += fallbacks_;
+	misses += misses_;
+
+	hits_ = 0;
+	fallbacks_ = 0;
+	misses_ = 0;
+}
+
+Node* MonsterPool::Create(int type)
+{
+	Node* monster = prototypes_[type]->Clone(LOCAL);
+	monster->SetVar(VAR_MONSTERTYPE, type);
+
+	RigidBodyMoveTo* _RigidBodyMoveTo = new RigidBodyMoveTo(context_);
+	monster->AddComponent(_RigidBodyMoveTo, 0, LOCAL);
+	_RigidBodyMoveTo->SetKinematic(kinematic_);
+
+	return monster;
+}
@@ -0,0 +1,49 @@
+/*
+ * MonsterPool.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Vector.h>
+
+namespace Urho3D
+{
+class Context;
+class Node;
+}
+
+using namespace Urho3D;
+
+//Pets cloned ahead of time, one free list per base pet. Released pets are disabled instead of removed so
+//their model, animation controller and body are reused by the next spawn. When the asked type has run dry
+//a pet of another type is handed out, only an empty pool clones a new one.
+class MonsterPool
+{
+public:
+	MonsterPool();
+
+	void Build(Context* context, const Vector<Node*>& prototypes, int capacity);
+	Node* Acquire(int type);
+	void Release(Node* monster);
+	void Clear();
+	//Adds the counters to the ones given and starts them over.
+	void TakeCounters(unsigned& hits, unsigned& fallbacks, unsigned& misses);
+
+	//Pets handed out move kinematically, see RigidBodyMoveTo::SetKinematic().
+	bool kinematic_;
+
+	unsigned hits_;
+	unsigned fallbacks_;
+	unsigned misses_;
+
+private:
+	Node* Create(int type);
+
+	Context* context_;
+	Vector<Node*> prototypes_;
+	Vector<PODVector<Node*> > free_;
+};
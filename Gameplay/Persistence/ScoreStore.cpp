@@ -0,0 +1,250 @@
+/*
+ * ScoreStore.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/FileSystem.h>
+#include <Urho3D/IO/Log.h>
+
+#ifdef WIN32
+#include <windows.h>
+#include <io.h>
+#include <stdio.h>
+#else
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+#include "ScoreStore.h"
+
+static const unsigned SCORE_RECORD_MAGIC = 0x43535742;//"BWSC"
+static const unsigned SCORE_RECORD_VERSION = 1;
+
+static unsigned GetRecordChecksum(unsigned magic, unsigned version, int topScore)
+{
+	//FNV-1a over the fields.
+	unsigned values[3] = { magic, version, (unsigned)topScore };
+	unsigned hash = 2166136261U;
+
+	for (int x = 0; x < 3; x++)
+	{
+		for (int y = 0; y < 4; y++)
+		{
+			hash ^= (values[x] >> (y * 8)) & 0xFF;
+			hash *= 16777619U;
+		}
+	}
+
+	return hash;
+}
+
+//File::Flush() only empties the C library buffer, the data has to reach the disk before the rename makes it the record.
+static bool SyncFile(File& file)
+{
+	file.Flush();
+
+	FILE* handle = (FILE*)file.GetHandle();
+
+	if (!handle)
+	{
+		return false;
+	}
+
+#ifdef WIN32
+	return FlushFileBuffers((HANDLE)_get_osfhandle(_fileno(handle))) != 0;
+#else
+	return fsync(fileno(handle)) == 0;
+#endif
+}
+
+//The rename itself is only durable once the directory entry is, Windows gets that from MOVEFILE_WRITE_THROUGH.
+static bool SyncDirectory(const String& fileName)
+{
+#ifdef WIN32
+	return true;
+#else
+	String dirName = GetPath(fileName);
+
+	if (dirName.Empty())
+	{
+		dirName = "./";
+	}
+
+	int fd = open(GetNativePath(dirName).CString(), O_RDONLY);
+
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	bool synced = fsync(fd) == 0;
+	close(fd);
+
+	return synced;
+#endif
+}
+
+static bool ReplaceFile(const String& srcFileName, const String& destFileName)
+{
+#ifdef WIN32
+	return MoveFileExW(WString(GetNativePath(srcFileName)).CString(), WString(GetNativePath(destFileName)).CString(),
+			MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	return rename(GetNativePath(srcFileName).CString(), GetNativePath(destFileName).CString()) == 0;
+#endif
+}
+
+ScoreStore::ScoreStore() :
+	batchWindow_(500),
+	submitted_(0),
+	written_(0),
+	context_(0),
+	pending_(false),
+	pendingScore_(0)
+{
+}
+
+ScoreStore::~ScoreStore()
+{
+	Shutdown();
+}
+
+void ScoreStore::Start(Context* context, const String& path)
+{
+	context_ = context;
+	path_ = path;
+
+	Run();
+}
+
+void ScoreStore::Submit(int topScore)
+{
+	MutexLock lock(mutex_);
+
+	if (!pending_)
+	{
+		pending_ = true;
+		pendingTimer_.Reset();
+	}
+
+	pendingScore_ = topScore;
+	submitted_++;
+}
+
+void ScoreStore::Shutdown()
+{
+	Stop();
+
+	//Whatever is still waiting for its batch window is written now.
+	if (pending_)
+	{
+		pending_ = false;
+		Write(pendingScore_);
+	}
+}
+
+bool ScoreStore::Load(int& topScore) const
+{
+	if (!context_ || !context_->GetSubsystem<FileSystem>()->FileExists(path_))
+	{
+		return false;
+	}
+
+	File file(context_, path_, FILE_READ);
+
+	if (!file.IsOpen() || file.GetSize() < 16)
+	{
+		return false;
+	}
+
+	unsigned magic = file.ReadUInt();
+	unsigned version = file.ReadUInt();
+	int score = file.ReadInt();
+	unsigned checksum = file.ReadUInt();
+
+	if (magic != SCORE_RECORD_MAGIC || version != SCORE_RECORD_VERSION
+			|| checksum != GetRecordChecksum(magic, version, score))
+	{
+		LOGWARNING("Score record " + path_ + " is damaged, keeping the stored top score");
+		return false;
+	}
+
+	topScore = score;
+
+	return true;
+}
+
+void ScoreStore::ThreadFunction()
+{
+	while (shouldRun_)
+	{
+		bool write = false;
+		int topScore = 0;
+
+		{
+			MutexLock lock(mutex_);
+
+			if (pending_ && pendingTimer_.GetMSec(false) >= batchWindow_)
+			{
+				pending_ = false;
+				topScore = pendingScore_;
+				write = true;
+			}
+		}
+
+		if (write)
+		{
+			Write(topScore);
+		}
+		else
+		{
+			Time::Sleep(10);
+		}
+	}
+}
+
+bool ScoreStore::Write(int topScore)
+{
+	String tempPath = path_ + ".tmp";
+
+	{
+		File file(context_, tempPath, FILE_WRITE);
+
+		if (!file.IsOpen())
+		{
+			return false;
+		}
+
+		file.WriteUInt(SCORE_RECORD_MAGIC);
+		file.WriteUInt(SCORE_RECORD_VERSION);
+		file.WriteInt(topScore);
+		file.WriteUInt(GetRecordChecksum(SCORE_RECORD_MAGIC, SCORE_RECORD_VERSION, topScore));
+
+		if (!SyncFile(file))
+		{
+			LOGERROR("Could not sync score record " + tempPath);
+			return false;
+		}
+	}
+
+	if (!ReplaceFile(tempPath, path_))
+	{
+		LOGERROR("Could not replace score record " + path_);
+		return false;
+	}
+
+	if (!SyncDirectory(path_))
+	{
+		LOGWARNING("Could not sync the directory of score record " + path_);
+	}
+
+	written_++;
+
+	return true;
+}
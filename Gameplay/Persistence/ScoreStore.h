@@ -0,0 +1,53 @@
+/*
+ * ScoreStore.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Core/Thread.h>
+#include <Urho3D/Core/Timer.h>
+
+namespace Urho3D
+{
+class Context;
+}
+
+using namespace Urho3D;
+
+//Saves the top score off the main thread. Submit() only keeps the newest value; the writer waits batchWindow_
+//milliseconds after the first pending change so changes close together become one write. The record goes to a
+//temp file that is renamed over the old one, so a crash leaves either the old record or the new one.
+class ScoreStore : public Thread
+{
+public:
+	ScoreStore();
+	virtual ~ScoreStore();
+
+	void Start(Context* context, const String& path);
+	void Submit(int topScore);
+	void Shutdown();
+	bool Load(int& topScore) const;
+
+	virtual void ThreadFunction();
+
+	unsigned batchWindow_;
+	unsigned submitted_;
+	unsigned written_;
+
+private:
+	bool Write(int topScore);
+
+	Context* context_;
+	String path_;
+
+	Mutex mutex_;
+	Timer pendingTimer_;
+	bool pending_;
+	int pendingScore_;
+};
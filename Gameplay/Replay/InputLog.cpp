@@ -0,0 +1,213 @@
+/*
+ * InputLog.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Context.h>
+#include <Urho3D/IO/Log.h>
+
+#include "InputLog.h"
+
+static const unsigned INPUT_LOG_MAGIC = 0x4E495742;//"BWIN"
+static const unsigned INPUT_LOG_VERSION = 1;
+
+//File::ReadVLE() can't tell a value cut off by the end of the file from a whole one. Same layout as
+//Serializer::WriteVLE(): up to three bytes of 7 bits with a continuation flag, then a last byte of 8 bits.
+static bool ReadWholeVLE(File& file, unsigned& value)
+{
+	value = 0;
+
+	for (int shift = 0; shift < 21; shift += 7)
+	{
+		if (file.IsEof())
+		{
+			return false;
+		}
+
+		unsigned char byte = file.ReadUByte();
+		value |= (unsigned)(byte & 0x7F) << shift;
+
+		if (!(byte & 0x80))
+		{
+			return true;
+		}
+	}
+
+	if (file.IsEof())
+	{
+		return false;
+	}
+
+	value |= (unsigned)file.ReadUByte() << 21;
+
+	return true;
+}
+
+static bool ReadRecord(File& file, unsigned& tickDelta, InputCommand& command)
+{
+	unsigned cell;
+
+	if (!ReadWholeVLE(file, tickDelta) || file.GetSize() - file.GetPosition() < 5)
+	{
+		return false;
+	}
+
+	command.type_ = file.ReadUByte();
+	command.value_ = file.ReadInt();
+
+	if (!ReadWholeVLE(file, cell))
+	{
+		return false;
+	}
+
+	command.cell_ = (int)cell - 1;
+
+	return true;
+}
+
+InputLog::InputLog() :
+	seed_(0),
+	lastTick_(0),
+	replaying_(false),
+	replayPos_(0)
+{
+}
+
+InputLog::~InputLog()
+{
+	if (file_)
+	{
+		file_->Close();
+	}
+}
+
+bool InputLog::OpenRecord(Context* context, const String& fileName, unsigned seed)
+{
+	file_ = new File(context, fileName, FILE_WRITE);
+
+	if (!file_->IsOpen())
+	{
+		LOGERROR("Could not open input log " + fileName + " for recording");
+		file_.Reset();
+		return false;
+	}
+
+	seed_ = seed;
+	lastTick_ = 0;
+
+	file_->WriteUInt(INPUT_LOG_MAGIC);
+	file_->WriteUInt(INPUT_LOG_VERSION);
+	file_->WriteUInt(seed_);
+
+	return true;
+}
+
+bool InputLog::OpenReplay(Context* context, const String& fileName)
+{
+	File file(context, fileName, FILE_READ);
+
+	if (!file.IsOpen() || file.ReadUInt() != INPUT_LOG_MAGIC || file.ReadUInt() != INPUT_LOG_VERSION)
+	{
+		LOGERROR("Could not read input log " + fileName);
+		return false;
+	}
+
+	seed_ = file.ReadUInt();
+	commands_.Clear();
+	replayPos_ = 0;
+
+	unsigned tick = 0;
+	unsigned tickDelta;
+	bool ended = false;
+	InputCommand command;
+
+	while (!file.IsEof())
+	{
+		if (!ReadRecord(file, tickDelta, command))
+		{
+			LOGWARNING("Input log " + fileName + " ends in a partial record, dropping it");
+			break;
+		}
+
+		tick += tickDelta;
+		command.tick_ = tick;
+
+		if (command.type_ == INPUT_END)
+		{
+			ended = true;
+			break;
+		}
+
+		if (command.type_ > INPUT_END)
+		{
+			LOGWARNING("Input log " + fileName + " holds an unknown record, the replay stops before it");
+			break;
+		}
+
+		commands_.Push(command);
+	}
+
+	//Logs from a session that never closed have no end record, finish on the tick of the last input instead.
+	if (!ended)
+	{
+		LOGWARNING("Input log " + fileName + " has no end record, the replay stops after its last input");
+	}
+
+	command.tick_ = tick;
+	command.type_ = INPUT_END;
+	command.value_ = 0;
+	command.cell_ = -1;
+	commands_.Push(command);
+
+	replaying_ = true;
+
+	return true;
+}
+
+void InputLog::Record(const InputCommand& command)
+{
+	if (!file_)
+	{
+		return;
+	}
+
+	file_->WriteVLE(command.tick_ - lastTick_);
+	file_->WriteUByte(command.type_);
+	file_->WriteInt(command.value_);
+	file_->WriteVLE((unsigned)(command.cell_ + 1));
+
+	lastTick_ = command.tick_;
+}
+
+bool InputLog::PopReplay(unsigned tick, InputCommand& command)
+{
+	if (replayPos_ >= commands_.Size() || commands_[replayPos_].tick_ > tick)
+	{
+		return false;
+	}
+
+	command = commands_[replayPos_++];
+
+	return true;
+}
+
+void InputLog::Close(unsigned tick)
+{
+	if (!file_)
+	{
+		return;
+	}
+
+	InputCommand command;
+	command.tick_ = tick;
+	command.type_ = INPUT_END;
+	command.value_ = 0;
+	command.cell_ = -1;
+	Record(command);
+
+	file_->Close();
+	file_.Reset();
+}
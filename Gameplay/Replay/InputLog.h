@@ -0,0 +1,62 @@
+/*
+ * InputLog.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Ptr.h>
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/IO/File.h>
+
+using namespace Urho3D;
+
+enum InputType
+{
+	INPUT_KEYDOWN = 0,
+	INPUT_KEYUP,
+	INPUT_MOUSEDOWN,//value_ holds the buttons, cell_ the picked cell.
+	INPUT_END//Last tick of the session.
+};
+
+struct InputCommand
+{
+	unsigned tick_;
+	unsigned char type_;
+	int value_;
+	int cell_;
+};
+
+//The random seed and every input with the physics tick it was applied on. Recording streams each command
+//to the file as it happens, ticks are stored as deltas. Replaying reads the whole log up front and hands
+//the commands back tick by tick. A log cut short by a crash loses its partial last record and ends after the
+//last whole one.
+class InputLog
+{
+public:
+	InputLog();
+	~InputLog();
+
+	bool OpenRecord(Context* context, const String& fileName, unsigned seed);
+	bool OpenReplay(Context* context, const String& fileName);
+	void Record(const InputCommand& command);
+	bool PopReplay(unsigned tick, InputCommand& command);
+	void Close(unsigned tick);
+
+	bool IsRecording() const { return file_.NotNull(); }
+	bool IsReplaying() const { return replaying_; }
+
+	unsigned seed_;
+
+private:
+	SharedPtr<File> file_;
+	unsigned lastTick_;
+
+	bool replaying_;
+	PODVector<InputCommand> commands_;
+	unsigned replayPos_;
+};
@@ -0,0 +1,116 @@
+/*
+ * TraceRecorder.cpp
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Core/Thread.h>
+#include <Urho3D/IO/File.h>
+#include <Urho3D/IO/Log.h>
+#include <Urho3D/Math/MathDefs.h>
+
+#include "TraceRecorder.h"
+
+#ifdef _MSC_VER
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL __thread
+#endif
+
+static TRACE_THREAD_LOCAL TraceBuffer* threadBuffer = 0;
+
+volatile bool TraceRecorder::enabled_ = false;
+unsigned TraceRecorder::capacity_ = 65536;
+HiresTimer TraceRecorder::clock_;
+Mutex TraceRecorder::mutex_;
+PODVector<TraceBuffer*> TraceRecorder::buffers_;
+
+TraceBuffer::TraceBuffer(unsigned capacity, unsigned threadIndex, bool mainThread) :
+	head_(0),
+	mask_(capacity - 1),
+	threadIndex_(threadIndex),
+	mainThread_(mainThread)
+{
+	events_.Resize(capacity);
+}
+
+void TraceRecorder::Start(unsigned capacity)
+{
+	MutexLock lock(mutex_);
+
+	capacity_ = NextPowerOfTwo(Max(capacity, 2U));
+
+	for (unsigned x = 0; x < buffers_.Size(); x++)
+	{
+		buffers_[x]->events_.Resize(capacity_);
+		buffers_[x]->mask_ = capacity_ - 1;
+		buffers_[x]->head_ = 0;
+	}
+
+	clock_.Reset();
+	enabled_ = true;
+}
+
+void TraceRecorder::Stop()
+{
+	enabled_ = false;
+}
+
+TraceBuffer* TraceRecorder::GetThreadBuffer()
+{
+	//Only the first event of a thread takes the lock.
+	if (!threadBuffer)
+	{
+		MutexLock lock(mutex_);
+		threadBuffer = new TraceBuffer(capacity_, buffers_.Size(), Thread::IsMainThread());
+		buffers_.Push(threadBuffer);
+	}
+
+	return threadBuffer;
+}
+
+bool TraceRecorder::Export(Context* context, const String& fileName)
+{
+	MutexLock lock(mutex_);
+
+	File file(context, fileName, FILE_WRITE);
+
+	if (!file.IsOpen())
+	{
+		LOGERROR("Could not write trace to " + fileName);
+		return false;
+	}
+
+	String json("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+
+	for (unsigned x = 0; x < buffers_.Size(); x++)
+	{
+		const TraceBuffer* buffer = buffers_[x];
+		unsigned head = buffer->head_;
+		unsigned count = Min(head, buffer->mask_ + 1);
+
+		json.AppendWithFormat("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+				first ? "" : ",\n", buffer->threadIndex_, buffer->mainThread_ ? "main" : "worker", buffer->threadIndex_);
+		first = false;
+
+		for (unsigned y = head - count; y != head; y++)
+		{
+			const TraceEvent& event = buffer->events_[y & buffer->mask_];
+
+			json.AppendWithFormat(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lld,\"dur\":%lld}",
+					event.name_, buffer->threadIndex_, event.start_, event.duration_);
+		}
+
+		//Keep the string from growing past what one write needs.
+		file.Write(json.CString(), json.Length());
+		json.Clear();
+	}
+
+	json.Append("\n]}\n");
+	file.Write(json.CString(), json.Length());
+
+	return true;
+}
@@ -0,0 +1,104 @@
+/*
+ * TraceRecorder.h
+ *
+ *  Created on: Oct 17, 2026
+ *      Author: practicing01
+ */
+
+#pragma once
+
+#include <Urho3D/Urho3D.h>
+#include <Urho3D/Container/Str.h>
+#include <Urho3D/Container/Vector.h>
+#include <Urho3D/Core/Mutex.h>
+#include <Urho3D/Core/Timer.h>
+
+namespace Urho3D
+{
+class Context;
+}
+
+using namespace Urho3D;
+
+struct TraceEvent
+{
+	const char* name_;
+	long long start_;
+	long long duration_;
+};
+
+//Newest events of one thread. Only the owning thread writes, so pushing takes no lock; once full the oldest
+//events are overwritten.
+class TraceBuffer
+{
+public:
+	TraceBuffer(unsigned capacity, unsigned threadIndex, bool mainThread);
+
+	void Push(const char* name, long long start, long long duration)
+	{
+		TraceEvent& event = events_[head_ & mask_];
+		event.name_ = name;
+		event.start_ = start;
+		event.duration_ = duration;
+		head_ = head_ + 1;
+	}
+
+	PODVector<TraceEvent> events_;
+	volatile unsigned head_;
+	unsigned mask_;
+	unsigned threadIndex_;
+	bool mainThread_;
+};
+
+//Timeline of TRACE zones from every thread that enters one, each thread recording into its own TraceBuffer.
+//Export() writes the Chrome trace-event format that chrome://tracing and Perfetto open. Start and Export are
+//meant to be called on the main thread while no work items are running.
+class TraceRecorder
+{
+public:
+	static void Start(unsigned capacity = 65536);
+	static void Stop();
+	static bool Export(Context* context, const String& fileName);
+
+	static bool IsEnabled() { return enabled_; }
+	static long long GetTime() { return clock_.GetUSec(false); }
+
+	static void Record(const char* name, long long start, long long duration)
+	{
+		GetThreadBuffer()->Push(name, start, duration);
+	}
+
+private:
+	static TraceBuffer* GetThreadBuffer();
+
+	static volatile bool enabled_;
+	static unsigned capacity_;
+	static HiresTimer clock_;
+	static Mutex mutex_;
+	static PODVector<TraceBuffer*> buffers_;
+};
+
+//Records the time from its construction to the end of the enclosing scope.
+class TraceZone
+{
+public:
+	TraceZone(const char* name) :
+		name_(name),
+		start_(TraceRecorder::IsEnabled() ? TraceRecorder::GetTime() : -1)
+	{
+	}
+
+	~TraceZone()
+	{
+		if (start_ >= 0 && TraceRecorder::IsEnabled())
+		{
+			TraceRecorder::Record(name_, start_, TraceRecorder::GetTime() - start_);
+		}
+	}
+
+private:
+	const char* name_;
+	long long start_;
+};
+
+#define TRACE(name) TraceZone traceZone_(name)
@@ -33,6 +33,7 @@
 #include <Urho3D/Core/Main.h>
 #include <Urho3D/Scene/Node.h>
 #include <Urho3D/Core/ProcessUtils.h>
+#include <Urho3D/Core/StringUtils.h>
 #include <Urho3D/Resource/ResourceCache.h>
 #include <Urho3D/Resource/ResourceEvents.h>
 #include <Urho3D/Scene/Scene.h>
@@ -45,15 +46,82 @@
 
 #include "MainMenu/MainMenu.h"
 
+//The benchmark links the same sources and brings its own application.
+#ifndef BITWEB_BENCHMARK
 DEFINE_APPLICATION_MAIN(Urho3DPlayer);
+#endif
 
 Urho3DPlayer::Urho3DPlayer(Context* context) :
     Application(context)
 {
+	timeStep_ = 0.0f;
+	headless_ = false;
+	tickRate_ = 60.0f;
+	realtime_ = false;
 }
 
 void Urho3DPlayer::Setup()
 {
+	//-headless is parsed by the engine, the rest are ours.
+	const Vector<String>& arguments = GetArguments();
+
+	for (unsigned x = 0; x < arguments.Size(); x++)
+	{
+		String argument = arguments[x].ToLower();
+
+		if (argument == "-tickrate" && x + 1 < arguments.Size())
+		{
+			tickRate_ = Max(ToFloat(arguments[++x]), 1.0f);
+		}
+		else if (argument == "-realtime")
+		{
+			realtime_ = true;
+		}
+		else if (argument == "-record" && x + 1 < arguments.Size())
+		{
+			recordPath_ = arguments[++x];
+		}
+		else if (argument == "-replay" && x + 1 < arguments.Size())
+		{
+			replayPath_ = arguments[++x];
+		}
+		else if (argument == "-trace" && x + 1 < arguments.Size())
+		{
+			tracePath_ = arguments[++x];
+		}
+		else if (argument == "-maze" && x + 1 < arguments.Size())
+		{
+			Vector<String> size = arguments[++x].ToLower().Split('x');
+
+			//A maze needs a cell besides the archer's for pets to spawn in.
+			if (size.Size() == 2 && ToInt(size[0]) > 0 && ToInt(size[1]) > 0 && ToInt(size[0]) * ToInt(size[1]) >= 2)
+			{
+				gameplayConfig_.mazeWidth_ = ToInt(size[0]);
+				gameplayConfig_.mazeHeight_ = ToInt(size[1]);
+			}
+			else
+			{
+				ErrorExit("Invalid maze size " + arguments[x] + ", expected WxH with at least 2 cells");
+				return;
+			}
+		}
+	}
+
+	//Replays always run headless and as fast as they can.
+	if (!replayPath_.Empty())
+	{
+		engineParameters_["Headless"] = true;
+		realtime_ = false;
+	}
+
+	headless_ = engineParameters_["Headless"].GetBool();
+
+	if (headless_)
+	{
+		engineParameters_["Sound"] = false;
+		return;
+	}
+
 	engineParameters_["WindowWidth"] = 800;
 	engineParameters_["WindowHeight"] = 600;
 	engineParameters_["WindowResizable"] = true;
@@ -66,8 +134,21 @@ void Urho3DPlayer::Setup()
 void Urho3DPlayer::Start()
 {
 	SetRandomSeed(GetSubsystem<Time>()->GetTimeSinceEpoch());
+	SetupSubsystems();
+
+	new MainMenu(context_, this);
+	//SubscribeToEvents();
+}
+
+void Urho3DPlayer::SetupSubsystems()
+{
 	input_ = GetSubsystem<Input>();
-	input_->SetMouseVisible(true);
+
+	if (!headless_)
+	{
+		input_->SetMouseVisible(true);
+	}
+
 	//input_->SetTouchEmulation(true);
 	graphics_ = GetSubsystem<Graphics>();
 	cache_ = GetSubsystem<ResourceCache>();
@@ -77,9 +158,17 @@ void Urho3DPlayer::Start()
 	ui_ = GetSubsystem<UI>();
 	engine_ = GetSubsystem<Engine>();
 	audio_ = GetSubsystem<Audio>();
+	workQueue_ = GetSubsystem<WorkQueue>();
 
-	new MainMenu(context_, this);
-	//SubscribeToEvents();
+	if (headless_)
+	{
+		//Without a window the engine is never focused and would fall back to the inactive frame limit.
+		int maxFps = realtime_ ? (int)tickRate_ : 0;
+		engine_->SetMaxFps(maxFps);
+		engine_->SetMaxInactiveFps(maxFps);
+
+		SubscribeToEvent(E_ENDFRAME, HANDLER(Urho3DPlayer, HandleEndFrame));
+	}
 }
 
 void Urho3DPlayer::Stop()
@@ -92,6 +181,12 @@ void Urho3DPlayer::SubscribeToEvents()
     //SubscribeToEvent(E_UPDATE, HANDLER(Urho3DPlayer, HandleUpdate));
 }
 
+void Urho3DPlayer::HandleEndFrame(StringHash eventType, VariantMap& eventData)
+{
+	//Every headless frame simulates exactly one tick, however long it really took.
+	engine_->SetNextTimeStep(1.0f / tickRate_);
+}
+
 void Urho3DPlayer::HandleUpdate(StringHash eventType, VariantMap& eventData)
 {
 	using namespace Update;
@@ -25,6 +25,7 @@
 #include <Urho3D/Urho3D.h>
 
 #include <Urho3D/Audio/Audio.h>
+#include <Urho3D/Core/WorkQueue.h>
 #include <Urho3D/Engine/Application.h>
 #include <Urho3D/IO/FileSystem.h>
 #include <Urho3D/Input/Input.h>
@@ -34,6 +35,8 @@
 #include <Urho3D/UI/UI.h>
 #include <Urho3D/Graphics/Viewport.h>
 
+#include "Gameplay/GameplayConfig.h"
+
 using namespace Urho3D;
 
 /// Urho3DPlayer application runs a script specified on the command line.
@@ -51,8 +54,24 @@ public:
     virtual void Start();
     /// Cleanup after the main loop. Run the script's stop function if it exists.
     virtual void Stop();
+    /// Fetch the subsystems and set up headless frame pacing.
+    void SetupSubsystems();
 
     float timeStep_;
+    /// Run without window, rendering and sound.
+    bool headless_;
+    /// Simulated seconds per frame are 1 / tickRate_ when headless.
+    float tickRate_;
+    /// Pace headless frames to the tick rate instead of running as fast as possible.
+    bool realtime_;
+    /// Input log to write while playing, empty for none.
+    String recordPath_;
+    /// Input log to play back headless, empty for none.
+    String replayPath_;
+    /// Chrome trace file to record gameplay stages into, empty for none.
+    String tracePath_;
+    /// Settings the next Gameplay starts from.
+    GameplayConfig gameplayConfig_;
     Input* input_;
     SharedPtr<Viewport> viewport_;
     SharedPtr<Scene> scene_;
@@ -65,10 +84,13 @@ public:
     SharedPtr<UI> ui_;
     SharedPtr<Engine> engine_;
     SharedPtr<Audio> audio_;
+    SharedPtr<WorkQueue> workQueue_;
 
 private:
     /// Subscribe to application-wide logic update events.
     void SubscribeToEvents();
     /// Handle the logic update event.
     void HandleUpdate(StringHash eventType, VariantMap& eventData);
+    /// Handle the end of frame event to fix the next frame's time step.
+    void HandleEndFrame(StringHash eventType, VariantMap& eventData);
 };